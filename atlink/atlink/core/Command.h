@@ -25,14 +25,26 @@ namespace Core {
 class Command : public APacket {
   public:
     explicit Command(const char *tag) : APacket{tag} {};
+    explicit Command(ReadOnlyText tag) : APacket{tag} {};
     virtual bool accept(ACommandVisitor &visitor) const = 0;
     virtual ~Command() = default;
 
+    // Raw bytes sent right after the command line, such as the data of a
+    // send command. They are written from where they are, never copied.
+    virtual gsl::span<const ReadOnlyText> payload() const {
+        return {};
+    }
+
   protected:
     template <typename... Args>
     bool acceptImpl(ACommandVisitor &visitor, Args &&...args) const {
         return APacket::acceptWithTerm(visitor, Constants::Cr, std::forward<Args>(args)...);
     }
+
+    template <typename Layout, typename... Args>
+    bool acceptFormatImpl(ACommandVisitor &visitor, const Layout &layout, Args &&...args) const {
+        return APacket::acceptFormat(visitor, Constants::Cr, layout, std::forward<Args>(args)...);
+    }
 };
 
 } // namespace Core
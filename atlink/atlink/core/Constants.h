@@ -27,11 +27,21 @@ namespace Literals {
 inline static constexpr Core::ReadOnlyText CrLf{"\r\n"};
 inline static constexpr Core::ReadOnlyText Cr{"\r"};
 inline static constexpr Core::ReadOnlyText Comma{","};
+inline static constexpr Core::ReadOnlyText OpenParen{"("};
+inline static constexpr Core::ReadOnlyText CloseParen{")"};
+inline static constexpr Core::ReadOnlyText Dash{"-"};
+inline static constexpr Core::ReadOnlyText NextItem{",("};
+inline static constexpr Core::ReadOnlyText Quote{"\""};
 } // namespace Literals
 
 inline static constexpr Core::Sequence Cr{Literals::Cr};
 inline static constexpr Core::Sequence CrLf{Literals::CrLf};
 inline static constexpr Core::Sequence Comma{Literals::Comma};
+inline static constexpr Core::Sequence OpenParen{Literals::OpenParen};
+inline static constexpr Core::Sequence CloseParen{Literals::CloseParen};
+inline static constexpr Core::Sequence Dash{Literals::Dash};
+inline static constexpr Core::Sequence NextItem{Literals::NextItem};
+inline static constexpr Core::Sequence Quote{Literals::Quote};
 
 } // namespace Constants
 } // namespace Core
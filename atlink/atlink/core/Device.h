@@ -17,8 +17,13 @@
 
 #pragma once
 
+#include "atlink/core/FinalResultCode.h"
 #include "atlink/core/fsm/Orchestrator.h"
 #include "atlink/platform/Facade.h"
+#include "atlink/protocols/standard/Ipr.h"
+#include "atlink/protocols/standard/Wire.h"
+
+#include <cstdint>
 
 namespace ATL_NS {
 namespace Core {
@@ -26,11 +31,12 @@ namespace Core {
 class Device {
 
     Platform::Logger logger;
+    Platform::DeviceIO &io;
     Fsm::Orchestrator orchestrator;
 
   public:
     Device(const char *name, Platform::DeviceIO &io, AUrcDispatcher &udp)
-        : logger{name}, orchestrator{io, udp} {}
+        : logger{name}, io{io}, orchestrator{io, udp} {}
 
     void loop() {
         orchestrator.loop();
@@ -41,6 +47,58 @@ class Device {
         return (ErrorCode::NoError == ec);
     }
 
+    // Negotiates the wire profile with the modem, e.g. numeric result codes
+    // to save bytes and parsing on high-rate polling. Call it once the loop
+    // runs and before other commands; the profile is only switched if the
+    // modem acknowledges it.
+    bool setWireProfile(const WireProfile &profile) {
+        Proto::Std::Wire::Write::Command cmd{};
+        cmd.s3 = profile.s3;
+        cmd.s4 = profile.s4;
+        cmd.verbose = profile.verbose ? 1 : 0;
+        FinalResultCode<> frc{};
+
+        const auto previous = orchestrator.wireProfile();
+        orchestrator.setRxWireProfile(profile);
+        const bool success = sendCommand(&frc, &cmd, nullptr) && frc.holds<Proto::Std::Ok>();
+        orchestrator.setWireProfile(success ? profile : previous);
+        if (!success) {
+            logger.error() << "wire profile rejected, keeping the current one";
+        }
+        return success;
+    }
+
+    // Moves the modem and the port to another baud rate with AT+IPR, e.g.
+    // to 921600 for bulk transfers. Use it with RTS/CTS flow control set
+    // in the SerialConfig at high rates. The port is only switched if the
+    // modem acknowledges the new rate.
+    bool setBaudRate(uint32_t rate) {
+        Proto::Std::Ipr::Write::Command cmd{};
+        cmd.rate = rate;
+        FinalResultCode<> frc{};
+
+        if (!sendCommand(&frc, &cmd, nullptr) || !frc.holds<Proto::Std::Ok>()) {
+            logger.error() << "baud rate " << rate << " rejected, keeping the current one";
+            return false;
+        }
+        if (!io.setBaudRate(rate)) {
+            logger.error() << "port cannot be switched to " << rate << " baud";
+            return false;
+        }
+        return true;
+    }
+
+    // Counters of the receive path, safe to read from any thread.
+    Statistics statistics() const {
+        return orchestrator.statistics();
+    }
+
+    // Sets a hook that sees every received line that was dropped because
+    // nothing could parse it. Pass nullptr to remove it.
+    void setRawLineHook(RawLineHook fn, void *ctx) {
+        orchestrator.setRawLineHook(fn, ctx);
+    }
+
     void shutDown() {
         orchestrator.shutDown();
     }
@@ -53,7 +53,7 @@ struct EnumTraits<T, std::enable_if_t<has_map<T>::value>> {
                   "Enum string map must be strictly sorted by key");
 
     static constexpr std::size_t N = std::tuple_size<MapRef>::value;
-    inline static const Utils::EnumCustomStringConverter<T, N> converter{MapProvider<T>::map};
+    inline static constexpr Utils::EnumCustomStringConverter<T, N> converter{MapProvider<T>::map};
 
   public:
     static size_t stringify(T value, MutableBuffer output) {
@@ -68,7 +68,7 @@ struct EnumTraits<T, std::enable_if_t<has_map<T>::value>> {
 template <typename T>
 struct EnumTraits<T, std::enable_if_t<!has_map<T>::value>> {
   private:
-    inline static const Utils::EnumStringConverter<T> converter{};
+    inline static constexpr Utils::EnumStringConverter<T> converter{};
 
   public:
     static size_t stringify(T value, MutableBuffer output) {
@@ -0,0 +1,299 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Command.h"
+#include "atlink/core/Response.h"
+#include "atlink/core/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ATL_NS {
+namespace Core {
+namespace Format {
+
+// Field specifiers understood by the format strings of ATL_RESPONSE and
+// ATL_COMMAND. An optional decimal width may precede the specifier, it
+// sets the capacity of string fields (e.g. "%32s") and the number of hex
+// digits written (e.g. "%8x"). "%ld" is a 64-bit integer and "%.Nf" a
+// fixed-point number with N decimals, N up to FixedPoint::MaxDecimals,
+// while a plain "%f" is a double.
+enum class Spec : char {
+    Invalid = '\0',
+    Int = 'd',
+    Int64 = 'D',
+    UInt = 'u',
+    Hex = 'x',
+    Double = 'f',
+    Fixed = 'F',
+    String = 's',
+};
+
+inline static constexpr std::size_t DefaultStringCapacity = 64U;
+
+struct Field {
+    Spec spec{Spec::Invalid};
+    std::size_t width{0U};
+    std::size_t precision{0U};
+    // Literal that follows the field, matched/emitted as a whole.
+    ReadOnlyText suffix{};
+};
+
+template <std::size_t N>
+struct Layout {
+    ReadOnlyText tag{};
+    std::array<Field, N> fields{};
+    bool valid{false};
+
+    static constexpr std::size_t size() {
+        return N;
+    }
+};
+
+// Whitespace in front of a field is skipped by the parser anyway, so
+// literals are stored without it. This lets "+CSQ: %d" match "+CSQ:5" too.
+constexpr ReadOnlyText trimRight(ReadOnlyText str) {
+    while ((0U < str.size()) && ((' ' == str.back()) || ('\t' == str.back()))) {
+        str.remove_suffix(1U);
+    }
+    return str;
+}
+
+constexpr std::size_t count(ReadOnlyText format) {
+    std::size_t n = 0U;
+    for (char c : format) {
+        n += (('%' == c) ? 1U : 0U);
+    }
+    return n;
+}
+
+constexpr Spec toSpec(char c) {
+    switch (c) {
+    case 'd':
+        return Spec::Int;
+    case 'u':
+        return Spec::UInt;
+    case 'x':
+        return Spec::Hex;
+    case 'f':
+        return Spec::Double;
+    case 's':
+        return Spec::String;
+    default:
+        return Spec::Invalid;
+    }
+}
+
+constexpr std::size_t parseNumber(ReadOnlyText format, std::size_t &pos) {
+    std::size_t n = 0U;
+    while ((pos < format.size()) && ('0' <= format[pos]) && (format[pos] <= '9')) {
+        n = (n * 10U) + static_cast<std::size_t>(format[pos] - '0');
+        ++pos;
+    }
+    return n;
+}
+
+template <std::size_t N>
+constexpr Layout<N> parse(ReadOnlyText format) {
+    Layout<N> layout{};
+    layout.valid = true;
+
+    auto pos = format.find('%');
+    layout.tag = trimRight(format.substr(0U, pos));
+
+    for (std::size_t i = 0U; i < N; ++i) {
+        auto &field = layout.fields[i];
+        ++pos;
+
+        field.width = parseNumber(format, pos);
+
+        const bool fixed = (pos < format.size()) && ('.' == format[pos]);
+        if (fixed) {
+            ++pos;
+            field.precision = parseNumber(format, pos);
+        }
+        const bool wide = (pos < format.size()) && ('l' == format[pos]);
+        if (wide) {
+            ++pos;
+        }
+
+        field.spec = (pos < format.size()) ? toSpec(format[pos]) : Spec::Invalid;
+        if (fixed) {
+            const bool fits = (field.precision <= FixedPoint::MaxDecimals);
+            field.spec = ((Spec::Double == field.spec) && fits) ? Spec::Fixed : Spec::Invalid;
+        } else if (wide) {
+            field.spec = (Spec::Int == field.spec) ? Spec::Int64 : Spec::Invalid;
+        }
+        if (Spec::Invalid == field.spec) {
+            layout.valid = false;
+            return layout;
+        }
+        ++pos;
+
+        const auto next = format.find('%', pos);
+        field.suffix = trimRight(format.substr(pos, next - pos));
+        pos = next;
+    }
+
+    return layout;
+}
+
+template <std::size_t Width>
+struct HexField : Hex {
+    HexField() : Hex{0U, static_cast<uint8_t>(Width), false} {}
+};
+
+template <std::size_t Decimals>
+struct FixedField : FixedPoint {
+    FixedField() : FixedPoint{0, static_cast<uint8_t>(Decimals)} {}
+};
+
+template <Spec S, std::size_t Width, std::size_t Precision>
+struct FieldTypeOf;
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::Int, Width, Precision> {
+    using type = int;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::Int64, Width, Precision> {
+    using type = int64_t;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::UInt, Width, Precision> {
+    using type = uint32_t;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::Hex, Width, Precision> {
+    using type = HexField<Width>;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::Double, Width, Precision> {
+    using type = double;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::Fixed, Width, Precision> {
+    using type = FixedField<Precision>;
+};
+
+template <std::size_t Width, std::size_t Precision>
+struct FieldTypeOf<Spec::String, Width, Precision> {
+    using type = QuotedField<(0U < Width) ? Width : DefaultStringCapacity>;
+};
+
+template <Spec S, std::size_t Width, std::size_t Precision>
+using FieldType = typename FieldTypeOf<S, Width, Precision>::type;
+
+} // namespace Format
+} // namespace Core
+} // namespace ATL_NS
+
+// --- Declaration helpers -------------------------------------------------
+//
+//   ATL_RESPONSE(Csq, "+CSQ: %d,%d", rssi, ber);
+//   ATL_COMMAND(CpinWrite, "AT+CPIN=%d", pin);
+//
+// Both declare a class with one public member per field. The text before the
+// first specifier becomes the tag, the text after each specifier is matched
+// (or emitted) verbatim. Up to 12 fields are supported.
+
+#define ATL_DETAIL_EXPAND(x) x
+#define ATL_DETAIL_CAT_IMPL(a, b) a##b
+#define ATL_DETAIL_CAT(a, b) ATL_DETAIL_CAT_IMPL(a, b)
+#define ATL_DETAIL_FIRST(first, ...) first
+
+#define ATL_DETAIL_NARGS_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, N, ...) N
+#define ATL_DETAIL_NARGS(...)                                                                      \
+    ATL_DETAIL_EXPAND(ATL_DETAIL_NARGS_IMPL(__VA_ARGS__, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+
+// Apply M(index, name) to every argument but the first (the format string).
+#define ATL_DETAIL_FIELDS_1(M, f)
+#define ATL_DETAIL_FIELDS_2(M, f, a) M(0, a)
+#define ATL_DETAIL_FIELDS_3(M, f, a, b) M(0, a) M(1, b)
+#define ATL_DETAIL_FIELDS_4(M, f, a, b, c) M(0, a) M(1, b) M(2, c)
+#define ATL_DETAIL_FIELDS_5(M, f, a, b, c, d) M(0, a) M(1, b) M(2, c) M(3, d)
+#define ATL_DETAIL_FIELDS_6(M, f, a, b, c, d, e) M(0, a) M(1, b) M(2, c) M(3, d) M(4, e)
+#define ATL_DETAIL_FIELDS_7(M, f, a, b, c, d, e, g)                                                \
+    ATL_DETAIL_FIELDS_6(M, f, a, b, c, d, e) M(5, g)
+#define ATL_DETAIL_FIELDS_8(M, f, a, b, c, d, e, g, h)                                             \
+    ATL_DETAIL_FIELDS_7(M, f, a, b, c, d, e, g) M(6, h)
+#define ATL_DETAIL_FIELDS_9(M, f, a, b, c, d, e, g, h, i)                                          \
+    ATL_DETAIL_FIELDS_8(M, f, a, b, c, d, e, g, h) M(7, i)
+#define ATL_DETAIL_FIELDS_10(M, f, a, b, c, d, e, g, h, i, j)                                      \
+    ATL_DETAIL_FIELDS_9(M, f, a, b, c, d, e, g, h, i) M(8, j)
+#define ATL_DETAIL_FIELDS_11(M, f, a, b, c, d, e, g, h, i, j, k)                                   \
+    ATL_DETAIL_FIELDS_10(M, f, a, b, c, d, e, g, h, i, j) M(9, k)
+#define ATL_DETAIL_FIELDS_12(M, f, a, b, c, d, e, g, h, i, j, k, l)                                \
+    ATL_DETAIL_FIELDS_11(M, f, a, b, c, d, e, g, h, i, j, k) M(10, l)
+#define ATL_DETAIL_FIELDS_13(M, f, a, b, c, d, e, g, h, i, j, k, l, m)                             \
+    ATL_DETAIL_FIELDS_12(M, f, a, b, c, d, e, g, h, i, j, k, l) M(11, m)
+#define ATL_DETAIL_FIELDS(M, ...)                                                                  \
+    ATL_DETAIL_EXPAND(                                                                             \
+        ATL_DETAIL_CAT(ATL_DETAIL_FIELDS_, ATL_DETAIL_NARGS(__VA_ARGS__))(M, __VA_ARGS__))
+
+#define ATL_DETAIL_MEMBER(I, name)                                                                 \
+    ::ATL_NS::Core::Format::FieldType<layout.fields[I].spec,                                       \
+                                      layout.fields[I].width,                                      \
+                                      layout.fields[I].precision>                                  \
+        name{};
+#define ATL_DETAIL_ARGUMENT(I, name) , name
+
+#define ATL_DETAIL_FORMAT(...)                                                                     \
+    ::ATL_NS::Core::ReadOnlyText {                                                                 \
+        ATL_DETAIL_EXPAND(ATL_DETAIL_FIRST(__VA_ARGS__))                                           \
+    }
+
+// Field names must not collide with the generated `layout` member.
+#define ATL_DETAIL_LAYOUT(...)                                                                     \
+    static constexpr auto layout = ::ATL_NS::Core::Format::parse<::ATL_NS::Core::Format::count(  \
+        ATL_DETAIL_FORMAT(__VA_ARGS__))>(ATL_DETAIL_FORMAT(__VA_ARGS__));                          \
+    static_assert(layout.valid, "Invalid field specifier in format string");                      \
+    static_assert(layout.size() + 1U == ATL_DETAIL_NARGS(__VA_ARGS__),                             \
+                  "Number of field names must match the format string");
+
+#define ATL_RESPONSE(Name, ...)                                                                    \
+    class Name : public ::ATL_NS::Core::Response {                                                 \
+      public:                                                                                      \
+        ATL_DETAIL_LAYOUT(__VA_ARGS__)                                                             \
+        ATL_DETAIL_FIELDS(ATL_DETAIL_MEMBER, __VA_ARGS__)                                          \
+        static constexpr ::ATL_NS::Core::ReadOnlyText Tag = layout.tag;                            \
+        Name() : ::ATL_NS::Core::Response(layout.tag) {}                                           \
+        bool accept(::ATL_NS::Core::AResponseVisitor &visitor) override {                          \
+            return Response::acceptFormatImpl(                                                     \
+                visitor, layout ATL_DETAIL_FIELDS(ATL_DETAIL_ARGUMENT, __VA_ARGS__));              \
+        }                                                                                          \
+    }
+
+#define ATL_COMMAND(Name, ...)                                                                     \
+    class Name : public ::ATL_NS::Core::Command {                                                  \
+      public:                                                                                      \
+        ATL_DETAIL_LAYOUT(__VA_ARGS__)                                                             \
+        ATL_DETAIL_FIELDS(ATL_DETAIL_MEMBER, __VA_ARGS__)                                          \
+        Name() : ::ATL_NS::Core::Command(layout.tag) {}                                            \
+        bool accept(::ATL_NS::Core::ACommandVisitor &visitor) const override {                     \
+            return Command::acceptFormatImpl(                                                      \
+                visitor, layout ATL_DETAIL_FIELDS(ATL_DETAIL_ARGUMENT, __VA_ARGS__));              \
+        }                                                                                          \
+    }
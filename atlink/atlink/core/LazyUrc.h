@@ -0,0 +1,151 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/TagSet.h"
+#include "atlink/core/Urc.h"
+#include "atlink/utils/Deserializer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <type_traits>
+
+namespace ATL_NS {
+namespace Core {
+
+// A URC as received: the raw line, which of the dispatcher's types its tag
+// names and when it arrived. It is parsed only by a subscriber that needs
+// the data, and can be copied to hand it over to another thread.
+template <std::size_t Capacity>
+class RawUrc {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // Index of the URC type in the dispatcher, see LazyUrcDispatcher::idOf.
+    std::size_t tag{0U};
+    Clock::time_point received{};
+    // Set if the line did not fit and was cut.
+    bool truncated{false};
+
+    ReadOnlyText line() const {
+        return ReadOnlyText{storage.data(), length};
+    }
+
+    // Parses the line into its typed response.
+    template <typename T>
+    bool decode(T &out) const {
+        static_assert(std::is_base_of<Response, T>::value, "T must derive from Response");
+        Utils::Deserializer deserializer{line(), wire};
+        return out.accept(deserializer);
+    }
+
+  private:
+    template <std::size_t, typename...>
+    friend class LazyUrcDispatcher;
+
+    std::array<char, Capacity> storage;
+    std::size_t length{0U};
+    WireProfile wire{};
+};
+
+// URC dispatcher that only matches tags. A line is recorded and handed to
+// the subscriber of its type, if there is one, and skipped otherwise, so
+// floods of URCs nobody reads cost a tag lookup each. Lines with an unknown
+// tag go to the subscriber set by subscribeUnknown(), and are left to the
+// caller if there is none. Handlers run on the device thread and must not
+// block.
+template <std::size_t Capacity, typename... Rs>
+class LazyUrcDispatcher : public AUrcDispatcher {
+    static_assert((HasStaticTag<Rs>::value && ...), "All Rs must declare their Tag");
+
+    static constexpr TagSet<sizeof...(Rs)> tags{
+        std::array<ReadOnlyText, sizeof...(Rs)>{staticTag<Rs>()...}};
+    static_assert(tags.prefixFree(), "URC tags must not be prefixes of each other");
+
+  public:
+    using Record = RawUrc<Capacity>;
+    using Handler = void (*)(const Record &urc, void *ctx);
+
+    static constexpr std::size_t unknown = sizeof...(Rs);
+
+    explicit LazyUrcDispatcher(WireProfile wire = {}) : wire{wire} {}
+
+    template <typename T>
+    static constexpr std::size_t idOf() {
+        constexpr bool matches[] = {std::is_same<T, Rs>::value...};
+        std::size_t i = 0U;
+        while ((i < sizeof...(Rs)) && !matches[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    template <typename T>
+    void subscribe(Handler fn, void *ctx) {
+        static_assert(idOf<T>() < unknown, "T is not one of the dispatcher's URCs");
+        handlers[idOf<T>()] = Subscription{fn, ctx};
+    }
+
+    void subscribeUnknown(Handler fn, void *ctx) {
+        handlers[unknown] = Subscription{fn, ctx};
+    }
+
+    std::size_t dispatch(ReadOnlyText str) override {
+        const char blank[] = {wire.s3, wire.s4, '\0'};
+        const auto start = std::min(str.find_first_not_of(blank), str.size());
+        const auto end = str.find(wire.lineEnd(), start);
+        if ((ReadOnlyText::npos == end) || (start == end)) {
+            return 0U;
+        }
+        auto consumed = end + 1U;
+        if ((consumed < str.size()) && (wire.s4 == str[consumed])) {
+            ++consumed;
+        }
+
+        const auto line = str.substr(start, consumed - start);
+        const auto id = std::min(tags.find(line), unknown);
+        const auto &handler = handlers[id];
+        if ((unknown == id) && (nullptr == handler.fn)) {
+            return 0U;
+        }
+        if (nullptr != handler.fn) {
+            record.tag = id;
+            record.received = Record::Clock::now();
+            record.truncated = (Capacity < line.size());
+            record.length = std::min(line.size(), Capacity);
+            record.wire = wire;
+            std::copy_n(line.data(), record.length, record.storage.data());
+            handler.fn(record, handler.ctx);
+        }
+        return consumed;
+    }
+
+  private:
+    struct Subscription {
+        Handler fn{nullptr};
+        void *ctx{nullptr};
+    };
+
+    const WireProfile wire;
+    std::array<Subscription, sizeof...(Rs) + 1U> handlers{};
+    Record record{};
+};
+
+} // namespace Core
+} // namespace ATL_NS
@@ -0,0 +1,214 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Constants.h"
+#include "atlink/core/Packet.h"
+
+#include <array>
+#include <type_traits>
+
+namespace ATL_NS {
+namespace Core {
+
+struct Range {
+    int first{0};
+    int last{0};
+
+    constexpr bool contains(int value) const {
+        return (first <= value) && (value <= last);
+    }
+};
+
+// Parenthesised set of values and ranges as found in test responses,
+// e.g. "(0-2)" or "(0,2,4-6)". A single value v is stored as v-v. Entries
+// that do not fit into N are dropped and reported by truncated().
+template <std::size_t N>
+class RangeField : public AResponseField {
+  public:
+    bool accept(AResponseVisitor &visitor) override {
+        count = 0U;
+        dropped = false;
+
+        if (!visitor.visit(Constants::OpenParen)) {
+            return false;
+        }
+        if (visitor.visit(Constants::CloseParen)) {
+            return true;
+        }
+
+        do {
+            // Parsed in place, a visit replayed from ParseProgress does not
+            // write its target again and must find the earlier value there.
+            Range &range = (count < N) ? ranges[count] : spare;
+            if (!visitor.visit(range.first)) {
+                return false;
+            }
+            if (visitor.visit(Constants::Dash)) {
+                if (!visitor.visit(range.last)) {
+                    return false;
+                }
+            } else {
+                range.last = range.first;
+            }
+            if (count < N) {
+                ++count;
+            } else {
+                dropped = true;
+            }
+        } while (visitor.visit(Constants::Comma));
+
+        return visitor.visit(Constants::CloseParen);
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    const Range &operator[](std::size_t i) const {
+        return ranges[i];
+    }
+
+    const Range *begin() const {
+        return ranges.data();
+    }
+
+    const Range *end() const {
+        return ranges.data() + count;
+    }
+
+    bool truncated() const {
+        return dropped;
+    }
+
+    bool contains(int value) const {
+        for (const auto &range : *this) {
+            if (range.contains(value)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    std::array<Range, N> ranges{};
+    Range spare{};
+    std::size_t count{0U};
+    bool dropped{false};
+};
+
+// One parenthesised entry of a List, e.g. (2,"Op","Op","26201",7).
+class ListItem : public APacket {
+  public:
+    ListItem() : APacket{} {}
+    virtual bool accept(AResponseVisitor &visitor) = 0;
+
+  protected:
+    template <typename... Args>
+    bool acceptImpl(AResponseVisitor &visitor, Args &&...args) {
+        return APacket::acceptFields(visitor, std::forward<Args>(args)...);
+    }
+};
+
+// Comma separated list of parenthesised items, as in
+// +COPS: (2,"Op","Op","26201",7),(1,"Op2","Op2","26202",2),,(0-4),(0-2)
+// Up to N items are kept, the rest is parsed into a spare item and counted
+// as dropped. A sink, if set, sees every item as soon as it is parsed, so
+// lists of any length can be consumed with N = 0. The sink is called on
+// every parse attempt, also on ones the enclosing response later rejects.
+// Replayed visits would hand it stale items, so a list with a sink is
+// parsed without the progress of earlier attempts.
+template <typename Item, std::size_t N>
+class List : public AResponseField {
+    static_assert(std::is_base_of<ListItem, Item>::value, "Item must derive from ListItem");
+    static_assert(std::is_default_constructible<Item>::value,
+                  "Item must be default-constructible");
+
+  public:
+    using Sink = void (*)(const Item &item, void *ctx);
+
+    void setSink(Sink fn, void *ctx) {
+        sink = fn;
+        sinkCtx = ctx;
+    }
+
+    // An absent list (no opening parenthesis) is accepted as empty.
+    bool accept(AResponseVisitor &visitor) override {
+        count = 0U;
+        dropped = 0U;
+
+        if (nullptr != sink) {
+            visitor.discardProgress();
+        }
+        if (!visitor.visit(Constants::OpenParen)) {
+            return true;
+        }
+
+        do {
+            Item &item = (count < N) ? items[count] : spare;
+            if (!item.accept(visitor) || !visitor.visit(Constants::CloseParen)) {
+                return false;
+            }
+            if (nullptr != sink) {
+                sink(item, sinkCtx);
+            }
+            if (count < N) {
+                ++count;
+            } else {
+                ++dropped;
+            }
+        } while (visitor.visit(Constants::NextItem));
+
+        return true;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    const Item &operator[](std::size_t i) const {
+        return items[i];
+    }
+
+    const Item *begin() const {
+        return items.data();
+    }
+
+    const Item *end() const {
+        return items.data() + count;
+    }
+
+    bool truncated() const {
+        return 0U < dropped;
+    }
+
+    std::size_t droppedCount() const {
+        return dropped;
+    }
+
+  private:
+    std::array<Item, N> items{};
+    Item spare{};
+    std::size_t count{0U};
+    std::size_t dropped{0U};
+    Sink sink{nullptr};
+    void *sinkCtx{nullptr};
+};
+
+} // namespace Core
+} // namespace ATL_NS
@@ -21,6 +21,9 @@
 #include "atlink/core/Enum.h"
 #include "atlink/core/Types.h"
 
+#include <tuple>
+#include <type_traits>
+
 namespace ATL_NS {
 namespace Core {
 
@@ -30,6 +33,11 @@ class ACommandVisitor {
     virtual bool visit(const QuotedStringView) = 0;
     virtual bool visit(const AEnum &) = 0;
     virtual bool visit(int) = 0;
+    virtual bool visit(int64_t) = 0;
+    virtual bool visit(uint32_t) = 0;
+    virtual bool visit(const Hex &) = 0;
+    virtual bool visit(const FixedPoint &) = 0;
+    virtual bool visit(double) = 0;
     virtual size_t written() const = 0;
     virtual ~ACommandVisitor() = default;
 };
@@ -41,11 +49,35 @@ class AResponseVisitor {
     virtual bool visit(LineText &) = 0;
     virtual bool visit(AEnum &) = 0;
     virtual bool visit(int &) = 0;
+    virtual bool visit(int64_t &) = 0;
+    virtual bool visit(uint32_t &) = 0;
+    virtual bool visit(Hex &) = 0;
+    virtual bool visit(FixedPoint &) = 0;
+    virtual bool visit(double &) = 0;
+    virtual bool visit(const ResultCode &) = 0;
+    // Unparsed input from where the next tag would start, i.e. past any
+    // line ends and blanks. Nothing is consumed.
+    virtual ReadOnlyText lookahead() const = 0;
     virtual void rewind() = 0;
+    // Forgets the visits recorded by earlier attempts and records no more
+    // in this one, for fields that act on what they parse and so must not
+    // have visits replayed.
+    virtual void discardProgress() = 0;
     virtual size_t consumed() const = 0;
+    // True if a visit failed only because the input ended before its line
+    // did, so the same packet may still match once more bytes arrive.
+    virtual bool exhausted() const = 0;
     virtual ~AResponseVisitor() = default;
 };
 
+// Field made of several visits, such as a parenthesised list. It drives
+// the visitor itself instead of being a visitor primitive.
+class AResponseField {
+  public:
+    virtual bool accept(AResponseVisitor &visitor) = 0;
+    virtual ~AResponseField() = default;
+};
+
 class APacket {
   public:
     Sequence tag;
@@ -91,18 +123,139 @@ class APacket {
         return visitor.visit(term);
     }
 
+    // Visits the fields only, separated by commas, without tag and terminator.
+    template <typename... Args>
+    bool acceptFields(AResponseVisitor &visitor, Args &&...args) {
+        return visitWithCommas(visitor, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    bool acceptFields(ACommandVisitor &visitor, Args &&...args) const {
+        return visitWithCommas(visitor, std::forward<Args>(args)...);
+    }
+
+    // Like acceptWithTerm, but the separators between the fields are taken
+    // from a Format::Layout instead of being fixed commas.
+    template <typename Visitor, typename Layout, typename... Args>
+    bool acceptFormat(Visitor &visitor,
+                      const Sequence &term,
+                      const Layout &layout,
+                      Args &&...args) const {
+        static_assert(sizeof...(args) == std::tuple_size<decltype(layout.fields)>::value,
+                      "Number of fields must match the format");
+        if (tag.length() > 0U) {
+            if (!visitor.visit(tag))
+                return false;
+        }
+        if constexpr (sizeof...(args) > 0) {
+            if (!visitFormatted<0U>(visitor, layout, std::forward<Args>(args)...))
+                return false;
+        }
+        return visitor.visit(term);
+    }
+
   private:
-    template <typename Visitor, typename First, typename... Rest>
-    static bool visitWithCommas(Visitor &visitor, First &&first, Rest &&...rest) {
-        if (!visitor.visit(std::forward<First>(first)))
+    template <typename Visitor, typename T>
+    static bool visitField(Visitor &visitor, T &&field) {
+        if constexpr (std::is_base_of<AResponseField, std::decay_t<T>>::value) {
+            return field.accept(visitor);
+        } else {
+            return visitor.visit(std::forward<T>(field));
+        }
+    }
+
+    template <std::size_t N>
+    static bool visitField(AResponseVisitor &visitor, QuotedField<N> &field) {
+        return visitor.visit(field.storage());
+    }
+
+    template <std::size_t N>
+    static bool visitField(ACommandVisitor &visitor, const QuotedField<N> &field) {
+        return visitor.visit(field.view());
+    }
+
+    template <typename T>
+    struct IsOptional : std::false_type {};
+
+    template <typename T>
+    struct IsOptional<Optional<T>> : std::true_type {};
+
+    template <typename T>
+    static constexpr bool isOptional = IsOptional<std::decay_t<T>>::value;
+
+    template <typename T>
+    static bool isPresent(const T &field) {
+        if constexpr (isOptional<T>) {
+            return field.present;
+        } else {
+            return true;
+        }
+    }
+
+    template <typename T>
+    static bool visitField(AResponseVisitor &visitor, Optional<T> &field) {
+        field.present = visitField(visitor, field.value);
+        return true;
+    }
+
+    template <typename T>
+    static bool visitField(ACommandVisitor &visitor, const Optional<T> &field) {
+        return field.present ? visitField(visitor, field.value) : true;
+    }
+
+    template <typename First, typename... Rest>
+    static bool visitWithCommas(AResponseVisitor &visitor, First &&first, Rest &&...rest) {
+        if (!visitField(visitor, std::forward<First>(first)))
+            return false;
+        if constexpr (sizeof...(rest) > 0) {
+            if (!visitor.visit(Constants::Comma)) {
+                // Trailing optional fields may be omitted along with their commas.
+                if constexpr ((isOptional<Rest> && ...)) {
+                    (rest.reset(), ...);
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+            return visitWithCommas(visitor, std::forward<Rest>(rest)...);
+        }
+        return true;
+    }
+
+    template <typename First, typename... Rest>
+    static bool visitWithCommas(ACommandVisitor &visitor, First &&first, Rest &&...rest) {
+        if (!visitField(visitor, std::forward<First>(first)))
             return false;
         if constexpr (sizeof...(rest) > 0) {
+            // No commas are written for absent optional fields at the end.
+            if (!(isPresent(rest) || ...))
+                return true;
             if (!visitor.visit(Constants::Comma))
                 return false;
             return visitWithCommas(visitor, std::forward<Rest>(rest)...);
         }
         return true;
     }
+
+    template <std::size_t Index,
+              typename Visitor,
+              typename Layout,
+              typename First,
+              typename... Rest>
+    static bool
+    visitFormatted(Visitor &visitor, const Layout &layout, First &&first, Rest &&...rest) {
+        if (!visitField(visitor, std::forward<First>(first)))
+            return false;
+        const auto &suffix = layout.fields[Index].suffix;
+        if (0U < suffix.size()) {
+            if (!visitor.visit(Sequence{suffix}))
+                return false;
+        }
+        if constexpr (sizeof...(rest) > 0) {
+            return visitFormatted<Index + 1U>(visitor, layout, std::forward<Rest>(rest)...);
+        }
+        return true;
+    }
 };
 
 } // namespace Core
@@ -0,0 +1,104 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Command.h"
+#include "atlink/utils/Serializer.h"
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace ATL_NS {
+namespace Core {
+
+// Command for hot polls whose bytes barely change between sends, e.g.
+// AT+QIRD=0,1500 where only the length may vary:
+//
+//   PreparedCommand<16U, int> qird{"AT+QIRD=", 0};
+//   qird.arg<0>() = 1500;
+//
+// The tag and the fixed leading arguments are serialized once, into the
+// command itself, when it is constructed. Each send then emits them as a
+// single sequence and serializes only the Tail arguments. Without fixed
+// arguments the tag literal is used as is and nothing is copied. The tag
+// and the fixed arguments are only known at run time; if they do not fit
+// into N bytes, the command is not valid() and refuses to serialize.
+template <std::size_t N, typename... Tail>
+class PreparedCommand : public Command {
+  public:
+    template <typename... Fixed>
+    explicit PreparedCommand(ReadOnlyText tag, const Fixed &...fixed)
+        : Command(tag), prefix{tag} {
+        static_assert((0U == sizeof...(Fixed)) || (0U < N), "N leaves no room for the prefix");
+        if constexpr (sizeof...(Fixed) > 0) {
+            auto serializer = Utils::Serializer{storage};
+            prepared = serializer.visit(this->tag) && acceptFields(serializer, fixed...);
+            if constexpr (sizeof...(Tail) > 0) {
+                prepared = prepared && serializer.visit(Constants::Comma);
+            }
+            prefix = serializer.output();
+        }
+    }
+
+    // Not copyable, the prefix may point into the command's own storage.
+    PreparedCommand(const PreparedCommand &) = delete;
+    PreparedCommand &operator=(const PreparedCommand &) = delete;
+
+    template <std::size_t I>
+    auto &arg() {
+        return std::get<I>(args);
+    }
+
+    template <std::size_t I>
+    const auto &arg() const {
+        return std::get<I>(args);
+    }
+
+    ReadOnlyText constantPart() const {
+        return prefix;
+    }
+
+    bool valid() const {
+        return prepared;
+    }
+
+    bool accept(ACommandVisitor &visitor) const override {
+        if (!prepared || !visitor.visit(Sequence{prefix})) {
+            return false;
+        }
+        if constexpr (sizeof...(Tail) > 0) {
+            auto visitTail = [&](const auto &...tail) {
+                return acceptFields(visitor, tail...);
+            };
+            if (!std::apply(visitTail, args)) {
+                return false;
+            }
+        }
+        return visitor.visit(Constants::Cr);
+    }
+
+  private:
+    std::array<char, N> storage{};
+    ReadOnlyText prefix;
+    bool prepared{true};
+    std::tuple<Tail...> args{};
+};
+
+} // namespace Core
+} // namespace ATL_NS
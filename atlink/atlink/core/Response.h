@@ -44,6 +44,7 @@ class Line : public APacket {
 class Response : public APacket {
   public:
     explicit Response(const char *tag) : APacket{tag} {}
+    explicit Response(ReadOnlyText tag) : APacket{tag} {}
     virtual bool accept(AResponseVisitor &visitor) = 0;
     virtual ~Response() = default;
 
@@ -53,6 +54,13 @@ class Response : public APacket {
         (void)visitor.visit(Constants::CrLf);
         return APacket::acceptWithTerm(visitor, Constants::CrLf, std::forward<Args>(args)...);
     }
+
+    template <typename Layout, typename... Args>
+    bool acceptFormatImpl(AResponseVisitor &visitor, const Layout &layout, Args &&...args) {
+        (void)visitor.visit(Constants::CrLf);
+        return APacket::acceptFormat(
+            visitor, Constants::CrLf, layout, std::forward<Args>(args)...);
+    }
 };
 
 class MultiLineResponse : public Response {
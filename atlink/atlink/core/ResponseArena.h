@@ -0,0 +1,288 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/ResponsePack.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ATL_NS {
+namespace Core {
+
+class AResponseArena {
+  public:
+    // Returns a slot of at least `size` bytes, or nullptr if none is free.
+    virtual void *acquire(std::size_t size, std::size_t align) = 0;
+    virtual void release(void *slot) = 0;
+    virtual ~AResponseArena() = default;
+};
+
+// Fixed pool of equally sized slots shared by the commands of a device.
+// Slots are handed out and returned from any thread: a response is parsed
+// on the device thread and released by the caller.
+template <std::size_t SlotSize, std::size_t SlotCount>
+class ResponseArena : public AResponseArena {
+    static_assert((0U < SlotCount) && (SlotCount <= 32U), "SlotCount must be within 1..32");
+    static_assert(0U == (SlotSize % alignof(std::max_align_t)),
+                  "SlotSize must keep every slot maximally aligned");
+
+    static constexpr uint32_t AllSlots =
+        (32U == SlotCount) ? ~uint32_t{0U} : ((uint32_t{1U} << SlotCount) - 1U);
+
+  public:
+    void *acquire(std::size_t size, std::size_t align) override {
+        if ((SlotSize < size) || (alignof(std::max_align_t) < align)) {
+            return nullptr;
+        }
+
+        auto used = busy.load(std::memory_order_relaxed);
+        while (AllSlots != used) {
+            std::size_t index = 0U;
+            while (0U != (used & (uint32_t{1U} << index))) {
+                ++index;
+            }
+            const auto bit = uint32_t{1U} << index;
+            if (busy.compare_exchange_weak(
+                    used, used | bit, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return slots[index].data();
+            }
+        }
+        return nullptr;
+    }
+
+    void release(void *slot) override {
+        const auto offset = static_cast<unsigned char *>(slot) - slots[0].data();
+        const auto index = static_cast<std::size_t>(offset) / SlotSize;
+        busy.fetch_and(~(uint32_t{1U} << index), std::memory_order_release);
+    }
+
+    std::size_t available() const {
+        const auto used = busy.load(std::memory_order_relaxed);
+        std::size_t n = 0U;
+        for (std::size_t i = 0U; i < SlotCount; ++i) {
+            n += (0U == (used & (uint32_t{1U} << i))) ? 1U : 0U;
+        }
+        return n;
+    }
+
+  private:
+    alignas(std::max_align_t) std::array<std::array<unsigned char, SlotSize>, SlotCount> slots;
+    std::atomic<uint32_t> busy{0U};
+};
+
+// Owns an object living in an arena slot, destroys it and gives the slot
+// back when it goes out of scope.
+template <typename T>
+class ResponseHandle {
+  public:
+    ResponseHandle() = default;
+    ResponseHandle(T *object, void *slot, AResponseArena &arena)
+        : object{object}, slot{slot}, arena{&arena} {}
+
+    ResponseHandle(const ResponseHandle &) = delete;
+    ResponseHandle &operator=(const ResponseHandle &) = delete;
+
+    ResponseHandle(ResponseHandle &&other) noexcept {
+        swap(other);
+    }
+
+    ResponseHandle &operator=(ResponseHandle &&other) noexcept {
+        if (this != &other) {
+            reset();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~ResponseHandle() {
+        reset();
+    }
+
+    void reset() {
+        if (nullptr != object) {
+            object->~T();
+            arena->release(slot);
+            object = nullptr;
+            slot = nullptr;
+        }
+    }
+
+    T *get() const {
+        return object;
+    }
+
+    T *operator->() const {
+        return object;
+    }
+
+    T &operator*() const {
+        return *object;
+    }
+
+    explicit operator bool() const {
+        return nullptr != object;
+    }
+
+  private:
+    void swap(ResponseHandle &other) noexcept {
+        std::swap(object, other.object);
+        std::swap(slot, other.slot);
+        std::swap(arena, other.arena);
+    }
+
+    T *object{nullptr};
+    void *slot{nullptr};
+    AResponseArena *arena{nullptr};
+};
+
+// ResponsePack counterpart that keeps only the matching alternative, in an
+// arena slot, instead of embedding storage for the largest one. All
+// alternatives are tried in the same slot, which is returned to the arena
+// if none matches.
+template <typename... Rs>
+class ArenaPack : public AResponsePack {
+    static_assert(sizeof...(Rs) > 0, "ArenaPack requires at least one response type");
+    static_assert((std::is_base_of<Response, Rs>::value && ...),
+                  "All Rs must derive from ATL_NS::Core::Response");
+
+    static constexpr std::size_t npos = sizeof...(Rs);
+    static constexpr std::size_t size = std::max({sizeof(Rs)...});
+    static constexpr std::size_t align = std::max({alignof(Rs)...});
+
+  public:
+    explicit ArenaPack(AResponseArena &arena) : arena{arena} {}
+
+    bool accept(AResponseVisitor &visitor) override {
+        reset();
+        void *slot = arena.acquire(size, align);
+        if (nullptr == slot) {
+            return false;
+        }
+        if (tryAll<0U, Rs...>(visitor, slot)) {
+            return true;
+        }
+        arena.release(slot);
+        return false;
+    }
+
+    void reset() {
+        value.reset();
+        index = npos;
+    }
+
+    template <typename T>
+    bool holds() const noexcept {
+        return indexOf<T>() == index;
+    }
+
+    template <typename T>
+    T *getIf() const noexcept {
+        return holds<T>() ? static_cast<T *>(value.get()) : nullptr;
+    }
+
+    // Hands the matched response over to the caller.
+    ResponseHandle<Response> take() {
+        index = npos;
+        return std::move(value);
+    }
+
+  private:
+    template <typename T>
+    static constexpr std::size_t indexOf() {
+        constexpr bool matches[] = {std::is_same<T, Rs>::value...};
+        std::size_t i = 0U;
+        while ((i < sizeof...(Rs)) && !matches[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    template <std::size_t Index, typename T, typename... Rest>
+    bool tryAll(AResponseVisitor &visitor, void *slot) {
+        visitor.rewind();
+        auto *candidate = new (slot) T();
+        if (candidate->accept(visitor)) {
+            value = ResponseHandle<Response>{candidate, slot, arena};
+            index = Index;
+            return true;
+        }
+        candidate->~T();
+        if constexpr (sizeof...(Rest) > 0) {
+            return tryAll<Index + 1U, Rest...>(visitor, slot);
+        }
+        return false;
+    }
+
+    AResponseArena &arena;
+    ResponseHandle<Response> value{};
+    std::size_t index{npos};
+};
+
+// Stand-in for a Response of type T that holds an arena slot only while a
+// line is parsed for it, so a command answered by a plain OK costs no
+// storage for T. The object is kept across parse attempts that ran out of
+// input, which lets the Orchestrator resume it when the response arrives
+// in pieces; on any other failure the slot is given back.
+template <typename T>
+class ArenaResponse : public Response {
+    static_assert(std::is_base_of<Response, T>::value, "T must derive from Response");
+
+  public:
+    explicit ArenaResponse(AResponseArena &arena) : Response(""), arena{arena} {}
+
+    bool accept(AResponseVisitor &visitor) override {
+        if (!value) {
+            void *slot = arena.acquire(sizeof(T), alignof(T));
+            if (nullptr == slot) {
+                return false;
+            }
+            value = ResponseHandle<T>{new (slot) T(), slot, arena};
+        }
+        const bool success = value->accept(visitor);
+        if (!success && !visitor.exhausted()) {
+            value.reset();
+        }
+        return success;
+    }
+
+    ResponseHandle<T> &handle() {
+        return value;
+    }
+
+    T *get() const {
+        return value.get();
+    }
+
+    void reset() {
+        value.reset();
+    }
+
+  private:
+    AResponseArena &arena;
+    ResponseHandle<T> value{};
+};
+
+} // namespace Core
+} // namespace ATL_NS
@@ -17,11 +17,13 @@
 
 #pragma once
 
+#include <array>
 #include <type_traits>
 #include <utility>
 #include <variant>
 
 #include "atlink/core/Response.h"
+#include "atlink/core/TagSet.h"
 
 namespace ATL_NS {
 namespace Core {
@@ -40,9 +42,18 @@ class ResponsePack : public AResponsePack {
     static_assert((std::is_default_constructible<Rs>::value && ...),
                   "All Rs must be default-constructible for trial parsing");
 
+    static constexpr TagSet<sizeof...(Rs)> tags{
+        std::array<ReadOnlyText, sizeof...(Rs)>{staticTag<Rs>()...}};
+
   public:
     using Variant = std::variant<std::monostate, Rs...>;
 
+    // True if every alternative declares its Tag and the tags are
+    // prefix-free. The pack then parses only the alternative the input's
+    // tag names, followed by the untagged ones in order, instead of trying
+    // them all. Large URC sets can static_assert on it.
+    static constexpr bool singleCandidate = (HasStaticTag<Rs>::value && ...) && tags.prefixFree();
+
     ResponsePack() = default;
 
     void reset() {
@@ -52,7 +63,11 @@ class ResponsePack : public AResponsePack {
     // Try to parse with each alternative in order.
     // On success, stores the parsed object and returns true.
     bool accept(AResponseVisitor &visitor) override {
-        return tryAll<0, Rs...>(visitor);
+        if constexpr (singleCandidate) {
+            return tryByTag(visitor, std::index_sequence_for<Rs...>{});
+        } else {
+            return tryAll<0, Rs...>(visitor);
+        }
     }
 
     const Variant &getValue() const noexcept {
@@ -78,14 +93,16 @@ class ResponsePack : public AResponsePack {
     }
 
   private:
+    // Parses straight into the variant storage, so a match costs neither a
+    // temporary nor a copy. A failed candidate is replaced by monostate.
     template <typename T>
     bool tryOne(AResponseVisitor &visitor) {
         static_assert(std::is_base_of<Response, T>::value, "T must derive from Response");
-        T candidate{};
         visitor.rewind();
+        auto &candidate = value.template emplace<T>();
         auto match = candidate.accept(visitor);
-        if (match) {
-            value.template emplace<T>(std::move(candidate));
+        if (!match) {
+            value.template emplace<std::monostate>();
         }
         return match;
     }
@@ -103,6 +120,19 @@ class ResponsePack : public AResponsePack {
         return tryAll<Index + 1, Second, Rest...>(visitor);
     }
 
+    template <std::size_t... I>
+    bool tryByTag(AResponseVisitor &visitor, std::index_sequence<I...>) {
+        using Try = bool (ResponsePack::*)(AResponseVisitor &);
+        static constexpr std::array<Try, sizeof...(Rs)> candidates{&ResponsePack::tryOne<Rs>...};
+
+        visitor.rewind();
+        const auto index = tags.find(visitor.lookahead());
+        if ((tags.npos != index) && (this->*candidates[index])(visitor)) {
+            return true;
+        }
+        return ((!tags.isTagged(I) && tryOne<Rs>(visitor)) || ...);
+    }
+
   private:
     Variant value;
 };
@@ -0,0 +1,42 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Types.h"
+
+#include <cstdint>
+
+namespace ATL_NS {
+namespace Core {
+
+// Receive path counters of a device, see Device::statistics().
+struct Statistics {
+    // Lines no response, result code or URC would take.
+    uint32_t resyncs{0U};
+    // Times the receive buffer filled up without a complete line.
+    uint32_t overflows{0U};
+    // Bytes thrown away by both of the above.
+    uint64_t droppedBytes{0U};
+};
+
+// Sees every line the receive path drops, e.g. to log or capture it. It is
+// called on the device thread and must not block.
+using RawLineHook = void (*)(ReadOnlyText line, void *ctx);
+
+} // namespace Core
+} // namespace ATL_NS
@@ -0,0 +1,117 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace ATL_NS {
+namespace Core {
+
+// A packet type announces the tag it starts with as `static constexpr
+// ReadOnlyText Tag`. An empty Tag marks a packet that cannot be told by a
+// tag, such as a catch-all or a result code with a numeric form.
+template <typename T, typename = void>
+struct HasStaticTag : std::false_type {};
+
+template <typename T>
+struct HasStaticTag<T, std::void_t<decltype(T::Tag)>> : std::true_type {};
+
+template <typename T>
+constexpr ReadOnlyText staticTag() {
+    if constexpr (HasStaticTag<T>::value) {
+        return T::Tag;
+    } else {
+        return ReadOnlyText{};
+    }
+}
+
+// Compile-time analysis of the tags of a set of alternatives. The set is
+// prefix-free if no tag starts with another one, e.g. "+CSQ:" and "+CSQN:"
+// are, "+DUP:" twice or "+C" and "+CSQ:" are not. Then at most one tagged
+// alternative can match any input, and find() names it in O(log N).
+template <std::size_t N>
+class TagSet {
+  public:
+    static constexpr std::size_t npos = N;
+
+    constexpr explicit TagSet(const std::array<ReadOnlyText, N> &tags) : tags{tags} {
+        // Insertion sort, std::sort is not constexpr in C++17.
+        for (std::size_t i = 0U; i < N; ++i) {
+            sorted[i] = i;
+            for (std::size_t j = i; (0U < j) && (tags[sorted[j]] < tags[sorted[j - 1U]]); --j) {
+                const auto tmp = sorted[j];
+                sorted[j] = sorted[j - 1U];
+                sorted[j - 1U] = tmp;
+            }
+        }
+        // Untagged entries sort first; a prefix can only be its successor.
+        for (std::size_t i = 0U; i < N; ++i) {
+            const auto &tag = tags[sorted[i]];
+            if (tag.empty()) {
+                ++untagged;
+            } else if ((i + 1U < N) && isPrefix(tag, tags[sorted[i + 1U]])) {
+                disjoint = false;
+            }
+        }
+    }
+
+    constexpr bool prefixFree() const {
+        return disjoint;
+    }
+
+    constexpr bool isTagged(std::size_t index) const {
+        return !tags[index].empty();
+    }
+
+    // Index of the tagged alternative the input starts with, npos if none.
+    // Only meaningful for a prefix-free set.
+    constexpr std::size_t find(ReadOnlyText input) const {
+        // The candidate is the greatest tag not above the input.
+        std::size_t lo = untagged;
+        std::size_t hi = N;
+        while (lo < hi) {
+            const auto mid = lo + ((hi - lo) / 2U);
+            if (input < tags[sorted[mid]]) {
+                hi = mid;
+            } else {
+                lo = mid + 1U;
+            }
+        }
+        if ((untagged < lo) && isPrefix(tags[sorted[lo - 1U]], input)) {
+            return sorted[lo - 1U];
+        }
+        return npos;
+    }
+
+  private:
+    static constexpr bool isPrefix(ReadOnlyText prefix, ReadOnlyText text) {
+        return (prefix.size() <= text.size()) && (text.substr(0U, prefix.size()) == prefix);
+    }
+
+    std::array<ReadOnlyText, N> tags{};
+    std::array<std::size_t, N> sorted{};
+    std::size_t untagged{0U};
+    bool disjoint{true};
+};
+
+} // namespace Core
+} // namespace ATL_NS
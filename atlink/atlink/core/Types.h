@@ -18,6 +18,8 @@
 #pragma once
 
 #include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <gsl/span>
 #include <string_view>
 
@@ -47,17 +49,21 @@ class Sequence {
     }
 
     size_t parse(ReadOnlyText input) const {
-        auto start = input.find(seq);
         size_t n = 0U;
-        if (0U == start) {
+        if ((0U < seq.size()) && (seq.size() <= input.size()) &&
+            (0 == std::memcmp(input.data(), seq.data(), seq.size()))) {
             n = seq.size();
         }
         return n;
     }
 
-    size_t length() const {
+    constexpr size_t length() const {
         return seq.size();
     }
+
+    constexpr ReadOnlyText view() const {
+        return seq;
+    }
 };
 
 class FixedBufStream {
@@ -120,6 +126,68 @@ class FixedBufStream {
     std::size_t len;
 };
 
+// Unsigned integer transmitted as hex digits, e.g. the cell id in
+// +CREG: 2,1,"1A2B","01C4D5E6". Leading zeros are written up to `width`.
+struct Hex {
+    uint32_t value{0U};
+    uint8_t width{0U};
+    bool quoted{false};
+};
+
+// Decimal number kept as an integer scaled by 10^decimals, e.g. "52.5205"
+// with 4 decimals is stored as 525205. Surplus fraction digits are dropped.
+struct FixedPoint {
+    // 10^18 is the largest power of ten raw can hold.
+    static constexpr uint8_t MaxDecimals = 18U;
+
+    int64_t raw{0};
+    uint8_t decimals{0U};
+};
+
+// Field that may be left empty or, at the end of a line, omitted together
+// with its comma, e.g. the trailing fields of +CREG: 0,1 vs
+// +CREG: 2,1,"1A2B","01C4D5E6",7. Absent fields are not written by commands.
+template <typename T>
+struct Optional {
+    T value{};
+    bool present{false};
+
+    explicit operator bool() const {
+        return present;
+    }
+
+    Optional &operator=(const T &v) {
+        value = v;
+        present = true;
+        return *this;
+    }
+
+    void reset() {
+        present = false;
+    }
+};
+
+// Framing set up on the modem with ATS3, ATS4 and ATV. Commands end with
+// S3, responses are framed by S3 S4. With verbose result codes off (ATV0)
+// a final result is sent as its number followed by S3 only, e.g. "0\r".
+struct WireProfile {
+    char s3{'\r'};
+    char s4{'\n'};
+    bool verbose{true};
+
+    // Character after which a received line may be complete.
+    constexpr char lineEnd() const {
+        return verbose ? s4 : s3;
+    }
+};
+
+// Final result code in both of its forms, e.g. "OK" and 0. The visitor
+// picks the form the wire profile calls for.
+struct ResultCode {
+    ReadOnlyText text;
+    uint8_t number{0U};
+};
+
 using QuotedStringView = ReadOnlyText;
 using QuotedStringStorage = MutableBuffer;
 
@@ -152,7 +220,9 @@ class QuotedField {
     }
 
   private:
-    std::array<char, N> chars{};
+    // Only the prefix up to the terminator written by clear() or by the
+    // parser is ever read, so the array is not zero-filled.
+    std::array<char, N> chars;
     FixedBufStream fb;
 };
 
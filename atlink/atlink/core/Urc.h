@@ -26,9 +26,13 @@ namespace Core {
 
 class AnyUrc : public Response {
   public:
-    std::array<char, 512U> storage{};
+    // Left uninitialized, the parser terminates what it writes.
+    std::array<char, 512U> storage;
     LineText payload{storage};
 
+    // Takes any line, so it is tried after the tagged URCs.
+    static constexpr ReadOnlyText Tag{};
+
     AnyUrc() : Response("") {}
 
     bool accept(AResponseVisitor &visitor) override {
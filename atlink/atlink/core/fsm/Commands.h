@@ -34,7 +34,7 @@ struct SendCommand {
     AResponsePack *result;
     const Core::Command *command;
     Response *response;
-    Platform::Semaphore *sem;
+    Platform::Completion *done;
 };
 
 } // namespace Command
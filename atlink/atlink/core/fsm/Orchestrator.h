@@ -17,17 +17,21 @@
 
 #pragma once
 
+#include "atlink/core/Statistics.h"
 #include "atlink/core/Urc.h"
 #include "atlink/core/fsm/Commands.h"
 #include "atlink/core/fsm/Context.h"
 #include "atlink/core/fsm/Events.h"
 #include "atlink/platform/Facade.h"
 #include "atlink/utils/Deserializer.h"
+#include "atlink/utils/GatherSerializer.h"
 #include "atlink/utils/Overload.h"
-#include "atlink/utils/Serializer.h"
 
 #include "atlink/core/fsm/State.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace ATL_NS {
 namespace Core {
 namespace Fsm {
@@ -42,38 +46,64 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
     State::Variant state{State::Idle{this}};
 
     Platform::MessageQueue<Fsm::Event> events{};
+    // RxReady and TxReady carry no data, so one of each in the queue is
+    // enough. This bounds the queue, whose put() waits while it is full:
+    // the FSM thread itself and the shared I/O and timer threads post them.
+    std::atomic<bool> rxQueued{false};
+    std::atomic<bool> txQueued{false};
     Platform::Timer coolDown{};
     Platform::Logger logger{"orchestrator"};
 
     std::array<char, 512U> rxstorage{};
     MutableBuffer rxbuf{rxstorage};
     size_t leftover{0U};
+    // Set when the buffered input was parsed as far as it goes; parsing is
+    // only retried once a new line end has been received.
+    bool rxStalled{false};
+
+    bool haveResponse{false};
+    bool haveResult{false};
+    Utils::ParseProgress responseProgress{};
 
-    std::array<char, 512U> txstorage{};
-    MutableBuffer txbuf{txstorage};
+    std::atomic<uint32_t> resyncs{0U};
+    std::atomic<uint32_t> overflows{0U};
+    std::atomic<uint64_t> droppedBytes{0U};
+    RawLineHook rawLineHook{nullptr};
+    void *rawLineCtx{nullptr};
+
+    // Separate for both directions, the answer to a command that changes
+    // the profile already uses the new one.
+    WireProfile txWire{};
+    WireProfile rxWire{};
 
   public:
     void notify(Platform::Api::Subscriber::Event ev) override {
         if (Platform::Api::Subscriber::Event::RxReady == ev) {
-            events.put(Fsm::Event::RxReady);
+            post(rxQueued, Fsm::Event::RxReady);
         }
     }
 
     static void timerCallback(void *ctx) {
         auto *o = static_cast<Orchestrator *>(ctx);
-        o->events.put(Fsm::Event::TxReady);
+        o->post(o->txQueued, Fsm::Event::TxReady);
     }
 
     explicit Orchestrator(Platform::DeviceIO &io, AUrcDispatcher &udp)
         : deviceIO{io}, urcDispatcher{udp} {
         deviceIO.subscribe(*this);
         coolDown.setHandler(timerCallback, this);
-        logger.setLogLevel(Platform::Api::Log::Level::Trace);
     }
 
     void loop() {
         while (true) {
             auto ev = events.get();
+            // Cleared before handling, so what arrives meanwhile is posted
+            // again.
+            if (Fsm::Event::RxReady == ev) {
+                (void)rxQueued.exchange(false, std::memory_order_acq_rel);
+            } else if (Fsm::Event::TxReady == ev) {
+                (void)txQueued.exchange(false, std::memory_order_acq_rel);
+            }
             if (Fsm::Event::ShutDown == ev) {
                 logger.info() << "Shutting down";
                 break;
@@ -83,6 +113,12 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
         }
     }
 
+    void post(std::atomic<bool> &queued, Fsm::Event ev) {
+        if (!queued.exchange(true, std::memory_order_acq_rel)) {
+            events.put(ev);
+        }
+    }
+
     void handle(Fsm::Event event) {
         auto handlers = Utils::Overload{
             [&](State::Idle &idle) -> State::Variant {
@@ -112,8 +148,16 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
     }
 
     bool send(const Core::Command &out) override {
-        auto serializer = Utils::Serializer{txbuf};
+        haveResponse = false;
+        haveResult = false;
+        responseProgress.reset();
+        rxStalled = false;
+
+        auto serializer = Utils::GatherSerializer{txWire};
         auto success = out.accept(serializer);
+        for (const auto &chunk : out.payload()) {
+            success = success && serializer.append(chunk);
+        }
         if (success) {
             auto len = serializer.written();
             auto n = deviceIO.write(serializer.output());
@@ -134,26 +178,42 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
 
     bool receive(AResponsePack &frc, Response *in) override {
 
+        discardIfFull();
         auto n = deviceIO.read(rxbuf.subspan(leftover));
         auto input = ReadOnlyText{rxbuf.data(), leftover + n};
 
-        auto tryResponse = [](Response *res, ReadOnlyText &txt) -> bool {
+        if (!hasNewLine(input, n)) {
+            leftover = input.size();
+            ATL_BLOG(logger, Trace, "RX: partial line, waiting (buffered=%zu bytes)", leftover);
+            return false;
+        }
+
+        // Set while the response ran out of input, its lines may still be
+        // arriving and must not be dropped.
+        bool responsePending = false;
+
+        auto tryResponse = [&](Response *res, ReadOnlyText &txt) -> bool {
             if (res == nullptr) {
                 return false;
             }
-            Utils::Deserializer deserializer{txt};
+            Utils::Deserializer deserializer{txt, responseProgress, rxWire};
             const bool success = res->accept(deserializer);
             if (success) {
                 txt = txt.substr(deserializer.consumed());
             }
+            responsePending = !success && deserializer.exhausted();
+            if (success || !deserializer.exhausted()) {
+                responseProgress.reset();
+            }
             return success;
         };
 
-        auto tryResult = [](AResponsePack &frc, ReadOnlyText &txt) -> bool {
-            Utils::Deserializer deserializer{txt};
+        auto tryResult = [this](AResponsePack &frc, ReadOnlyText &txt) -> bool {
+            Utils::Deserializer deserializer{txt, rxWire};
             const bool success = frc.accept(deserializer);
             if (success) {
                 txt = txt.substr(deserializer.consumed());
+                responseProgress.reset();
             }
             return success;
         };
@@ -162,17 +222,13 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
             const auto consumed = dispatchSingleUrc(txt);
             if (consumed > 0U) {
                 txt = txt.substr(consumed);
+                responseProgress.reset();
                 return true;
             }
             return false;
         };
 
-        bool haveResponse = (in == nullptr);
-        bool haveResult = false;
-
-        if (!haveResponse) {
-            haveResponse = tryResponse(in, input);
-        }
+        haveResponse = haveResponse || (in == nullptr);
 
         while (true) {
             const auto before = input.size();
@@ -197,19 +253,17 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
 
             const auto after = input.size();
             if (after == before) {
-                break;
+                if ((!haveResponse && responsePending) || !dropHeadLine(input)) {
+                    break;
+                }
             }
         }
 
-        for (size_t i = 0; i < input.size(); ++i) {
-            rxbuf[i] = input[i];
-        }
-
-        leftover = input.size();
+        keepLeftover(input);
 
         if (!haveResult || !haveResponse) {
-            logger.trace() << "RX: incomplete response, waiting (buffered=" << leftover
-                           << " bytes)";
+            ATL_BLOG(
+                logger, Trace, "RX: incomplete response, waiting (buffered=%zu bytes)", leftover);
         }
 
         return haveResult && haveResponse;
@@ -221,17 +275,128 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
 
     void dispatchUrcs() override {
 
+        discardIfFull();
         auto n = deviceIO.read(rxbuf.subspan(leftover));
         auto input = ReadOnlyText{rxbuf.data(), leftover + n};
 
-        auto consumed = dispatchAllUrcs(input);
-        input = input.substr(consumed);
+        if (!hasNewLine(input, n)) {
+            leftover = input.size();
+            return;
+        }
+
+        input = input.substr(dispatchAllUrcs(input));
+        while (dropHeadLine(input)) {
+            input = input.substr(dispatchAllUrcs(input));
+        }
+
+        keepLeftover(input);
+    }
+
+    Statistics statistics() const {
+        return Statistics{resyncs.load(std::memory_order_relaxed),
+                          overflows.load(std::memory_order_relaxed),
+                          droppedBytes.load(std::memory_order_relaxed)};
+    }
+
+    WireProfile wireProfile() {
+        Platform::Mutex::LockGuard g{mtx};
+        return txWire;
+    }
+
+    void setWireProfile(const WireProfile &profile) {
+        Platform::Mutex::LockGuard g{mtx};
+        txWire = profile;
+        rxWire = profile;
+    }
+
+    // Receives with the given profile while commands are still sent with
+    // the current one.
+    void setRxWireProfile(const WireProfile &profile) {
+        Platform::Mutex::LockGuard g{mtx};
+        rxWire = profile;
+    }
+
+    void setRawLineHook(RawLineHook fn, void *ctx) {
+        Platform::Mutex::LockGuard g{mtx};
+        rawLineHook = fn;
+        rawLineCtx = ctx;
+    }
+
+    // Called once the line at the head of the input was offered to every
+    // consumer and none took it. Nothing behind it can be parsed while it
+    // is there, so it is skipped up to its line end. Returns false if the
+    // head line is still incomplete.
+    bool dropHeadLine(ReadOnlyText &input) {
+        // Stray line ends between packets are skipped without reporting.
+        const char blank[] = {rxWire.s3, rxWire.s4, '\0'};
+        const auto start = std::min(input.find_first_not_of(blank), input.size());
+        if (0U < start) {
+            input = input.substr(start);
+            responseProgress.reset();
+            return true;
+        }
+
+        auto end = input.find(rxWire.lineEnd());
+        if (ReadOnlyText::npos == end) {
+            return false;
+        }
+        if (((end + 1U) < input.size()) && (rxWire.s4 == input[end + 1U])) {
+            ++end;
+        }
+        const auto line = input.substr(0U, end + 1U);
+        input = input.substr(line.size());
+        responseProgress.reset();
+
+        resyncs.fetch_add(1U, std::memory_order_relaxed);
+        droppedBytes.fetch_add(line.size(), std::memory_order_relaxed);
+        logger.warn() << "RX: dropping unparseable line (" << line.size() << " bytes)";
+        reportDropped(line);
+        return true;
+    }
+
+    // A full buffer leaves no room to receive the rest of its head line, so
+    // that line can never complete. It is dropped, or all of the input if
+    // it has no line end at all.
+    void discardIfFull() {
+        if (leftover < rxbuf.size()) {
+            return;
+        }
+        auto input = ReadOnlyText{rxbuf.data(), leftover};
+        if (!dropHeadLine(input)) {
+            overflows.fetch_add(1U, std::memory_order_relaxed);
+            droppedBytes.fetch_add(input.size(), std::memory_order_relaxed);
+            logger.warn() << "RX: buffer full, dropping " << input.size() << " bytes";
+            reportDropped(input);
+            input = input.substr(input.size());
+        }
+        keepLeftover(input);
+        rxStalled = false;
+    }
+
+    void reportDropped(ReadOnlyText line) {
+        if (nullptr != rawLineHook) {
+            rawLineHook(line, rawLineCtx);
+        }
+    }
 
-        for (size_t i = 0; i < input.size(); ++i) {
-            rxbuf[i] = input[i];
+    // Every packet ends with a line end, so as long as none arrived since the
+    // buffered input was last parsed, parsing it again cannot get further.
+    // Only the freshly read bytes are scanned, which keeps the work per
+    // received byte constant however small the chunks are.
+    bool hasNewLine(ReadOnlyText input, size_t received) const {
+        if (!rxStalled) {
+            return true;
         }
+        auto fresh = input.substr(input.size() - received);
+        return (ReadOnlyText::npos != fresh.find(rxWire.lineEnd()));
+    }
 
+    void keepLeftover(ReadOnlyText input) {
+        if (input.data() != rxbuf.data()) {
+            std::copy_n(input.data(), input.size(), rxbuf.data());
+        }
         leftover = input.size();
+        rxStalled = true;
     }
 
     size_t dispatchAllUrcs(ReadOnlyText input) {
@@ -266,7 +431,7 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
         }
 
         ErrorCode ec{ErrorCode::NoError};
-        Platform::Semaphore sem{};
+        Platform::Completion done{};
 
         logger.info() << "FSM: sending command";
 
@@ -275,7 +440,7 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
         payload.result = result;
         payload.command = cmd;
         payload.response = res;
-        payload.sem = &sem;
+        payload.done = &done;
 
         if (auto idle = std::get_if<State::Idle>(&state)) {
             logger.debug() << "FSM: idle → sendcommand";
@@ -289,7 +454,7 @@ class Orchestrator : public Context, public Platform::Api::Subscriber {
         mtx.unlock();
 
         if (ErrorCode::NoError == ec) {
-            sem.acquire();
+            done.wait();
             logger.info() << "FSM: command completed";
         } else {
             logger.error() << "FSM: command failed (" << static_cast<int>(ec) << ")";
@@ -36,7 +36,7 @@ inline Variant WaitForResponse::handle(const Event &event) {
         auto success = ctx->receive(*msg.result, msg.response);
         if (success) {
             logger.info() << "RX: complete response received";
-            msg.sem->release();
+            msg.done->complete();
             next = Variant{Idle{ctx}};
         }
         break;
@@ -17,6 +17,8 @@
 
 #pragma once
 #include "atlink/platform/Registry.h"
+#include "atlink/platform/api/BinaryLog.h"
+#include "atlink/platform/api/Completion.h"
 #include "atlink/platform/api/CondVar.h"
 #include "atlink/platform/api/DeviceIO.h"
 #include "atlink/platform/api/Logger.h"
@@ -28,17 +30,31 @@
 namespace ATL_NS {
 namespace Platform {
 
-#if defined(AT_PLATFORM_LINUX)
+#if defined(AT_PLATFORM_TAG)
+// A platform of the application's own, which names its tag here and
+// specialises Components for it before including this header.
+using ActiveTag = AT_PLATFORM_TAG;
+#elif defined(AT_PLATFORM_LINUX_URING)
+using ActiveTag = Tags::LinuxUring;
+#elif defined(AT_PLATFORM_LINUX_EPOLL)
+using ActiveTag = Tags::LinuxEpoll;
+#elif defined(AT_PLATFORM_LINUX)
 using ActiveTag = Tags::Linux;
 #else
 #error "no platform tag"
 #endif
 
+using BinaryLog = Api::BinaryLog<Components<ActiveTag>::BinaryLogImpl>;
+
+using Completion = Api::Completion<Components<ActiveTag>::CompletionImpl>;
+
 using CondVar = Api::CondVar<typename Components<ActiveTag>::CondVarImpl,
                              typename Components<ActiveTag>::MutexImpl>;
 
 using DeviceIO = Api::DeviceIO<typename Components<ActiveTag>::DeviceIOImpl>;
 
+using SerialConfig = Api::SerialConfig;
+
 using Logger = Api::Logger<typename Components<ActiveTag>::LoggerImpl>;
 
 template <class T>
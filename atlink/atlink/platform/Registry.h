@@ -18,13 +18,18 @@
 #pragma once
 
 #include "atlink/platform/Tags.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/BinaryLog.h"
+#include "atlink/platform/linux/Completion.h"
 #include "atlink/platform/linux/CondVar.h"
 #include "atlink/platform/linux/DeviceIO.h"
+#include "atlink/platform/linux/EpollDeviceIO.h"
 #include "atlink/platform/linux/Logger.h"
 #include "atlink/platform/linux/MessageQueue.h"
 #include "atlink/platform/linux/Mutex.h"
 #include "atlink/platform/linux/Semaphore.h"
 #include "atlink/platform/linux/Timer.h"
+#include "atlink/platform/linux/UringDeviceIO.h"
 
 namespace ATL_NS {
 namespace Platform {
@@ -34,9 +39,11 @@ struct Components;
 
 template <>
 struct Components<Tags::Linux> {
+    using BinaryLogImpl = Impl::Linux::BinaryLog;
+    using CompletionImpl = Impl::Linux::Completion;
     using CondVarImpl = Impl::Linux::CondVar;
     using DeviceIOImpl = Impl::Linux::DeviceIO;
-    using LoggerImpl = Impl::Linux::Logger;
+    using LoggerImpl = Impl::Linux::AsyncLogger;
     template <class T>
     using MessageQueueImpl = Impl::Linux::MessageQueue<T>;
     using MutexImpl = Impl::Linux::Mutex;
@@ -44,5 +51,15 @@ struct Components<Tags::Linux> {
     using TimerImpl = Impl::Linux::Timer;
 };
 
+template <>
+struct Components<Tags::LinuxEpoll> : Components<Tags::Linux> {
+    using DeviceIOImpl = Impl::Linux::EpollDeviceIO;
+};
+
+template <>
+struct Components<Tags::LinuxUring> : Components<Tags::Linux> {
+    using DeviceIOImpl = Impl::Linux::UringDeviceIO;
+};
+
 } // namespace Platform
 } // namespace ATL_NS
\ No newline at end of file
@@ -22,6 +22,12 @@ namespace Tags {
 
 struct Linux {};
 
+// Linux with the ttys of all devices served by one epoll thread.
+struct LinuxEpoll {};
+
+// Linux with tty I/O batched through one io_uring, or epoll without it.
+struct LinuxUring {};
+
 } // namespace Tags
 } // namespace Platform
 } // namespace ATL_NS
\ No newline at end of file
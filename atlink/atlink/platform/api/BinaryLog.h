@@ -0,0 +1,476 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/platform/api/Logger.h"
+#include "atlink/utils/Detector.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Log line whose text is formatted offline: with a binary log open, only
+// the site id, a timestamp and the raw arguments are stored, otherwise the
+// line is rendered and goes to the logger as usual. The format takes
+// printf conversions; strings are written escaped like tty data.
+//
+//   ATL_BLOG(logger, Trace, "rx read %zu bytes", n);
+//
+// Arguments are evaluated only when the line is logged.
+#define ATL_BLOG(logger, level, ...)                                                              \
+    ATL_BLOG_TO(ATL_NS::Platform::BinaryLog, logger, level, __VA_ARGS__)
+
+// Same, for code below the Facade, which names the BinaryLog itself.
+#define ATL_BLOG_TO(Sink, logger, level, ...)                                                      \
+    do {                                                                                           \
+        constexpr auto atlBlogLevel = ATL_NS::Platform::Api::Log::Level::level;                    \
+        if constexpr (ATL_NS::Platform::Api::Log::isCompiled(atlBlogLevel)) {                      \
+            if ((logger).wouldLog(atlBlogLevel)) {                                                 \
+                using AtlBlogSignature =                                                           \
+                    decltype(ATL_NS::Platform::Api::Blog::signature(__VA_ARGS__));                 \
+                static ATL_NS::Platform::Api::Blog::Site atlBlogSite{atlBlogLevel,                 \
+                                                                     ATL_BLOG_FORMAT(__VA_ARGS__), \
+                                                                     __FILE__,                     \
+                                                                     __LINE__,                     \
+                                                                     AtlBlogSignature::codes};     \
+                ATL_NS::Platform::Api::Blog::emit<Sink, atlBlogLevel>(                             \
+                    (logger), atlBlogSite, __VA_ARGS__);                                           \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
+
+#define ATL_BLOG_FORMAT(...) ATL_BLOG_FORMAT_(__VA_ARGS__, 0)
+#define ATL_BLOG_FORMAT_(format, ...) format
+
+namespace ATL_NS {
+namespace Platform {
+namespace Api {
+
+namespace Blog {
+
+// Argument type codes, as listed in a site's signature.
+namespace Type {
+constexpr char Int32 = 'i';
+constexpr char Int64 = 'I';
+constexpr char Uint32 = 'u';
+constexpr char Uint64 = 'U';
+constexpr char Double = 'd';
+constexpr char Char = 'c';
+constexpr char Bool = 'b';
+constexpr char String = 's'; // uint16 length, then the bytes
+} // namespace Type
+
+// Longest string argument kept; the rest is cut off.
+constexpr std::size_t MaxString = 4096U;
+
+template <typename T>
+struct Unsupported : std::false_type {};
+
+template <typename T>
+constexpr char typeOf() {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same<U, bool>::value) {
+        return Type::Bool;
+    } else if constexpr (std::is_same<U, char>::value) {
+        return Type::Char;
+    } else if constexpr (std::is_enum<U>::value) {
+        return typeOf<std::underlying_type_t<U>>();
+    } else if constexpr (std::is_integral<U>::value && std::is_signed<U>::value) {
+        return (sizeof(U) <= 4U) ? Type::Int32 : Type::Int64;
+    } else if constexpr (std::is_integral<U>::value) {
+        return (sizeof(U) <= 4U) ? Type::Uint32 : Type::Uint64;
+    } else if constexpr (std::is_floating_point<U>::value) {
+        return Type::Double;
+    } else if constexpr (std::is_convertible<U, std::string_view>::value) {
+        return Type::String;
+    } else {
+        static_assert(Unsupported<U>::value, "Binary log arguments: integers, floats or strings");
+        return '\0';
+    }
+}
+
+template <typename... Args>
+struct Signature {
+    static constexpr char codes[] = {typeOf<Args>()..., '\0'};
+};
+
+// Only named in decltype, to get the signature without evaluating the
+// arguments.
+template <typename Format, typename... Args>
+Signature<Args...> signature(const Format &, const Args &...);
+
+struct Site {
+    Log::Level level;
+    const char *format;
+    const char *file;
+    uint32_t line;
+    const char *types;
+    std::atomic<uint32_t> id{0U}; // 0 until defined in the binary log
+};
+
+// Every record starts with this header and is padded to 8 bytes. The size
+// is stored last, so a record reads as complete once it is non-zero.
+// Records with site 0 define a site: its id, line, level, the lengths of
+// the logger name, file, format and signature, then these strings.
+struct RecordHeader {
+    uint32_t size;
+    uint32_t site;
+    uint64_t time; // ns since the epoch
+};
+
+struct SiteHeader {
+    uint32_t id;
+    uint32_t line;
+    uint8_t level;
+    uint8_t reserved;
+    uint16_t nameLength;
+    uint16_t fileLength;
+    uint16_t formatLength;
+    uint16_t typesLength;
+    uint16_t padding;
+};
+
+constexpr std::size_t align8(std::size_t n) {
+    return (n + 7U) & ~std::size_t{7U};
+}
+
+template <typename T>
+std::size_t encodedSize(const T &value) {
+    constexpr char type = typeOf<T>();
+    if constexpr (Type::String == type) {
+        const std::string_view str{value};
+        return sizeof(uint16_t) + ((str.size() < MaxString) ? str.size() : MaxString);
+    } else if constexpr ((Type::Int64 == type) || (Type::Uint64 == type) ||
+                         (Type::Double == type)) {
+        return 8U;
+    } else if constexpr ((Type::Char == type) || (Type::Bool == type)) {
+        return 1U;
+    } else {
+        return 4U;
+    }
+}
+
+template <typename T>
+char *encode(char *out, const T &value) {
+    constexpr char type = typeOf<T>();
+    const auto put = [&out](const auto raw) {
+        std::memcpy(out, &raw, sizeof(raw));
+        out += sizeof(raw);
+    };
+    if constexpr (Type::String == type) {
+        const std::string_view str{value};
+        const auto length =
+            static_cast<uint16_t>((str.size() < MaxString) ? str.size() : MaxString);
+        put(length);
+        std::memcpy(out, str.data(), length);
+        out += length;
+    } else if constexpr (Type::Int32 == type) {
+        put(static_cast<int32_t>(value));
+    } else if constexpr (Type::Int64 == type) {
+        put(static_cast<int64_t>(value));
+    } else if constexpr (Type::Uint32 == type) {
+        put(static_cast<uint32_t>(value));
+    } else if constexpr (Type::Uint64 == type) {
+        put(static_cast<uint64_t>(value));
+    } else if constexpr (Type::Double == type) {
+        put(static_cast<double>(value));
+    } else {
+        put(static_cast<uint8_t>(value));
+    }
+    return out;
+}
+
+// Renders a line when no binary log is open. Each argument takes the next
+// conversion of the format; length modifiers are ignored, since the
+// argument types are known.
+class Text {
+  public:
+    static constexpr std::size_t SIZE = 256U;
+
+    explicit Text(const char *format) : format{format} {}
+
+    template <typename T>
+    void add(const T &value) {
+        std::array<char, 16U> spec{};
+        const char conversion = next(spec);
+        if ('\0' == conversion)
+            return;
+
+        constexpr char type = typeOf<T>();
+        if constexpr (Type::String == type) {
+            escape(std::string_view{value});
+        } else if constexpr (Type::Bool == type) {
+            if ('s' == conversion) {
+                append(value ? "true" : "false");
+            } else {
+                number(spec, conversion, static_cast<long long>(value));
+            }
+        } else if constexpr (Type::Double == type) {
+            number(spec, conversion, static_cast<double>(value));
+        } else if constexpr ((Type::Uint32 == type) || (Type::Uint64 == type)) {
+            number(spec, conversion, static_cast<unsigned long long>(value));
+        } else {
+            number(spec, conversion, static_cast<long long>(value));
+        }
+    }
+
+    // Copies the rest of the format, returns the text.
+    std::string_view finish() {
+        std::array<char, 16U> spec{};
+        while ('\0' != next(spec)) {
+        }
+        return {buf.data(), len};
+    }
+
+  private:
+    // Copies literal text up to the next conversion, whose spec without
+    // length modifier is left in spec. Returns the conversion character,
+    // or '\0' at the end of the format.
+    char next(std::array<char, 16U> &spec) {
+        while ('\0' != *format) {
+            if ('%' != *format) {
+                put(*format++);
+                continue;
+            }
+            if ('%' == format[1]) {
+                put('%');
+                format += 2;
+                continue;
+            }
+            std::size_t n = 0U;
+            spec[n++] = *format++;
+            while (('\0' != *format) && (nullptr != std::strchr("-+ #0123456789.", *format))) {
+                if (n < (spec.size() - 4U))
+                    spec[n++] = *format;
+                ++format;
+            }
+            while (('\0' != *format) && (nullptr != std::strchr("hlLqjzt", *format))) {
+                ++format;
+            }
+            spec[n] = '\0';
+            return ('\0' != *format) ? *format++ : '\0';
+        }
+        return '\0';
+    }
+
+    template <typename T>
+    void number(std::array<char, 16U> &spec, char conversion, T value) {
+        const bool real = (nullptr != std::strchr("eEfFgGaA", conversion));
+        const bool integer = (nullptr != std::strchr("diouxX", conversion));
+        std::size_t n = std::strlen(spec.data());
+        if ('c' == conversion) {
+            spec[n++] = 'c';
+            spec[n] = '\0';
+            print(spec.data(), static_cast<int>(value));
+        } else if (real || ((!integer) && std::is_floating_point<T>::value)) {
+            spec[n++] = real ? conversion : 'g';
+            spec[n] = '\0';
+            print(spec.data(), static_cast<double>(value));
+        } else {
+            spec[n++] = 'l';
+            spec[n++] = 'l';
+            spec[n++] = integer ? conversion : 'd';
+            spec[n] = '\0';
+            if (std::is_unsigned<T>::value || (nullptr != std::strchr("ouxX", conversion))) {
+                print(spec.data(), static_cast<unsigned long long>(value));
+            } else {
+                print(spec.data(), static_cast<long long>(value));
+            }
+        }
+    }
+
+    template <typename T>
+    void print(const char *spec, T value) {
+        const int n = std::snprintf(buf.data() + len, SIZE - len, spec, value);
+        if (0 < n) {
+            len += ((len + static_cast<std::size_t>(n)) < SIZE) ? static_cast<std::size_t>(n)
+                                                                : (SIZE - 1U - len);
+        }
+    }
+
+    void escape(std::string_view str) {
+        for (const char c : str) {
+            const auto byte = static_cast<unsigned char>(c);
+            if ('\r' == c) {
+                append("<CR>");
+            } else if ('\n' == c) {
+                append("<LF>");
+            } else if ((32U <= byte) && (byte < 127U)) {
+                put(c);
+            } else {
+                print("<0x%02X>", static_cast<unsigned>(byte));
+            }
+        }
+    }
+
+    void append(const char *s) {
+        while ('\0' != *s) {
+            put(*s++);
+        }
+    }
+
+    void put(char c) {
+        if (len < (SIZE - 1U)) {
+            buf[len++] = c;
+        }
+    }
+
+    const char *format;
+    std::array<char, SIZE> buf{};
+    std::size_t len{0U};
+};
+
+} // namespace Blog
+
+template <typename Backend>
+class BinaryLog {
+  public:
+    template <class B>
+    using expr_instance = decltype(B::instance());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<Backend &, expr_instance, Backend>,
+                  "BinaryLog Backend must provide: 'static Backend &instance()'");
+
+    template <class B>
+    using expr_enabled = decltype(std::declval<const B &>().enabled());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<bool, expr_enabled, Backend>,
+                  "BinaryLog Backend must provide: 'bool enabled() const'");
+
+    template <class B>
+    using expr_reserve = decltype(std::declval<B &>().reserve(std::declval<std::size_t>()));
+    static_assert(ATL_NS::Utils::is_detected_exact_v<char *, expr_reserve, Backend>,
+                  "BinaryLog Backend must provide: 'char *reserve(size_t)'");
+
+    template <class B>
+    using expr_timestamp = decltype(std::declval<const B &>().timestamp());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<uint64_t, expr_timestamp, Backend>,
+                  "BinaryLog Backend must provide: 'uint64_t timestamp() const'");
+
+    template <class B>
+    using expr_dropped = decltype(std::declval<const B &>().dropped());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<uint64_t, expr_dropped, Backend>,
+                  "BinaryLog Backend must provide: 'uint64_t dropped() const'");
+
+    static bool enabled() {
+        return Backend::instance().enabled();
+    }
+
+    // Records not stored because the log was full.
+    static uint64_t dropped() {
+        return Backend::instance().dropped();
+    }
+
+    template <typename... Args>
+    static void write(Blog::Site &site, const char *logger, const Args &...args) {
+        uint32_t id = site.id.load(std::memory_order_acquire);
+        if (0U == id) {
+            id = define(site, logger);
+        }
+
+        Backend &backend = Backend::instance();
+        const std::size_t size = Blog::align8(sizeof(Blog::RecordHeader) +
+                                              (std::size_t{0U} + ... + Blog::encodedSize(args)));
+        char *record = backend.reserve(size);
+        if (nullptr == record)
+            return;
+
+        Blog::RecordHeader header{0U, id, backend.timestamp()};
+        std::memcpy(record, &header, sizeof(header));
+        if constexpr (sizeof...(args) > 0) {
+            char *out = record + sizeof(header);
+            ((out = Blog::encode(out, args)), ...);
+        }
+        commit(record, size);
+    }
+
+  private:
+    // Writes the definition of a site and gives it an id. Threads racing
+    // on the same site may each write one; the id that gets stored wins
+    // and the other definitions are never referenced.
+    static uint32_t define(Blog::Site &site, const char *logger) {
+        static std::atomic<uint32_t> lastId{0U};
+        const uint32_t id = lastId.fetch_add(1U, std::memory_order_relaxed) + 1U;
+
+        const std::string_view strings[] = {
+            (nullptr != logger) ? logger : "", site.file, site.format, site.types};
+        Blog::SiteHeader info{};
+        info.id = id;
+        info.line = site.line;
+        info.level = static_cast<uint8_t>(site.level);
+        info.nameLength = static_cast<uint16_t>(strings[0].size());
+        info.fileLength = static_cast<uint16_t>(strings[1].size());
+        info.formatLength = static_cast<uint16_t>(strings[2].size());
+        info.typesLength = static_cast<uint16_t>(strings[3].size());
+
+        std::size_t size = sizeof(Blog::RecordHeader) + sizeof(info);
+        for (const auto &str : strings) {
+            size += str.size();
+        }
+        size = Blog::align8(size);
+
+        Backend &backend = Backend::instance();
+        char *record = backend.reserve(size);
+        if (nullptr != record) {
+            Blog::RecordHeader header{0U, 0U, backend.timestamp()};
+            std::memcpy(record, &header, sizeof(header));
+            char *out = record + sizeof(header);
+            std::memcpy(out, &info, sizeof(info));
+            out += sizeof(info);
+            for (const auto &str : strings) {
+                std::memcpy(out, str.data(), str.size());
+                out += str.size();
+            }
+            commit(record, size);
+        }
+
+        uint32_t expected = 0U;
+        if (!site.id.compare_exchange_strong(
+                expected, id, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return expected;
+        }
+        return id;
+    }
+
+    static void commit(char *record, std::size_t size) {
+        reinterpret_cast<std::atomic<uint32_t> *>(record)->store(static_cast<uint32_t>(size),
+                                                                  std::memory_order_release);
+    }
+};
+
+namespace Blog {
+
+template <typename Sink, Log::Level L, typename Logger, typename... Args>
+void emit(Logger &logger, Site &site, const char *format, const Args &...args) {
+    if (Sink::enabled()) {
+        Sink::write(site, logger.label(), args...);
+    } else {
+        Text text{format};
+        (text.add(args), ...);
+        logger.template line<L>() << text.finish();
+    }
+}
+
+} // namespace Blog
+
+} // namespace Api
+} // namespace Platform
+} // namespace ATL_NS
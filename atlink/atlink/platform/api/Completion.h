@@ -0,0 +1,60 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/utils/Detector.h"
+#include <utility>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Api {
+
+// One-shot signal from one thread to a single waiter, such as the caller
+// of a command waiting for its response.
+template <class Backend>
+class Completion {
+  private:
+    template <class T>
+    using expr_wait = decltype(std::declval<T &>().wait());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<void, expr_wait, Backend>,
+                  "Completion Backend must provide: void wait()");
+
+    template <class T>
+    using expr_complete = decltype(std::declval<T &>().complete());
+    static_assert(ATL_NS::Utils::is_detected_exact_v<void, expr_complete, Backend>,
+                  "Completion Backend must provide: void complete()");
+
+  public:
+    template <class... Args>
+    explicit Completion(Args &&...args) : impl{std::forward<Args>(args)...} {}
+
+    // Returns once complete() has been called, at once if it already was.
+    void wait() {
+        impl.wait();
+    }
+
+    void complete() {
+        impl.complete();
+    }
+
+  private:
+    Backend impl;
+};
+
+} // namespace Api
+} // namespace Platform
+} // namespace ATL_NS
@@ -19,6 +19,7 @@
 
 #include "atlink/utils/Detector.h"
 
+#include <cstdint>
 #include <gsl/span>
 #include <string_view>
 
@@ -36,6 +37,34 @@ class Subscriber {
     virtual ~Subscriber() = default;
 };
 
+// Line settings of a serial port. Rates without a standard constant,
+// such as 3000000 on some UARTs, are set as arbitrary rates where the
+// platform supports it.
+struct SerialConfig {
+    enum class Parity : unsigned char {
+        None,
+        Even,
+        Odd,
+    };
+
+    enum class FlowControl : unsigned char {
+        None,
+        RtsCts,
+    };
+
+    // Device path, read when the port is opened; nullptr takes it from
+    // the platform default (ATLINK_TTY on Linux).
+    const char *port{nullptr};
+    uint32_t baudRate{115200U};
+    unsigned char dataBits{8U};
+    Parity parity{Parity::None};
+    unsigned char stopBits{1U};
+    FlowControl flowControl{FlowControl::None};
+    // Asks the driver to hand over received bytes right away instead of
+    // batching them, at some CPU cost.
+    bool lowLatency{false};
+};
+
 template <typename Backend>
 class DeviceIO {
 
@@ -49,15 +78,30 @@ class DeviceIO {
     static_assert(ATL_NS::Utils::is_detected_exact_v<size_t, expr_write, Backend>,
                   "DeviceIO Backend must privide: 'size_t write(std::string_view)'");
 
+    template <class T>
+    using expr_writev = decltype(std::declval<T &>().write(
+        std::declval<gsl::span<const std::string_view>>()));
+    static_assert(ATL_NS::Utils::is_detected_exact_v<size_t, expr_writev, Backend>,
+                  "DeviceIO Backend must privide: "
+                  "'size_t write(gsl::span<const std::string_view>)'");
+
     template <class T>
     using expr_read = decltype(std::declval<T &>().read(std::declval<gsl::span<char>>()));
     static_assert(ATL_NS::Utils::is_detected_exact_v<size_t, expr_read, Backend>,
                   "DeviceIO Backend must privide: 'size_t read(gsl::span<char>)'");
 
+    template <class T>
+    using expr_setBaudRate = decltype(std::declval<T &>().setBaudRate(std::declval<uint32_t>()));
+    static_assert(ATL_NS::Utils::is_detected_exact_v<bool, expr_setBaudRate, Backend>,
+                  "DeviceIO Backend must privide: 'bool setBaudRate(uint32_t)'");
+
   private:
     Backend impl;
 
   public:
+    DeviceIO() = default;
+    explicit DeviceIO(const SerialConfig &config) : impl{config} {}
+
     void subscribe(Subscriber &listener) {
         impl.subscribe(listener);
     }
@@ -66,9 +110,21 @@ class DeviceIO {
         return impl.write(s);
     }
 
+    // Writes all chunks, in order, as one transfer. Returns the number of
+    // bytes written, which is only short of the total on a device error.
+    size_t write(gsl::span<const std::string_view> chunks) {
+        return impl.write(chunks);
+    }
+
     size_t read(gsl::span<char> buf) {
         return impl.read(buf);
     }
+
+    // Changes the rate of the open port once pending output is sent. The
+    // modem has to be switched as well, see Core::Device::setBaudRate.
+    bool setBaudRate(uint32_t baud) {
+        return impl.setBaudRate(baud);
+    }
 };
 
 } // namespace Api
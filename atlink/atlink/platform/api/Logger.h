@@ -17,11 +17,27 @@
 
 #pragma once
 
+#include "atlink/core/Enum.h"
 #include "atlink/core/Types.h"
+#include "atlink/utils/Detector.h"
+
 #include <charconv>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <type_traits>
 
+// Lines less severe than this level (0 = error ... 4 = trace) are compiled
+// out, arguments included as far as they have no side effects.
+#ifndef ATLINK_LOG_LEVEL_MIN
+#define ATLINK_LOG_LEVEL_MIN 4
+#endif
+
+// Level loggers start with, unless ATLINK_LOG_LEVEL is set at runtime.
+#ifndef ATLINK_LOG_LEVEL_DEFAULT
+#define ATLINK_LOG_LEVEL_DEFAULT 2
+#endif
+
 namespace ATL_NS {
 namespace Platform {
 namespace Api {
@@ -35,6 +51,39 @@ enum class Level : unsigned char {
     Trace,
 };
 
+constexpr bool isCompiled(Level level) {
+    return static_cast<unsigned>(level) <= ATLINK_LOG_LEVEL_MIN;
+}
+
+// ATLINK_LOG_LEVEL (error, warn, info, debug or trace) if set, else
+// ATLINK_LOG_LEVEL_DEFAULT. Read once.
+inline Level initialLevel() {
+    static const Level level = [] {
+        static constexpr const char *names[] = {"error", "warn", "info", "debug", "trace"};
+        if (const char *env = std::getenv("ATLINK_LOG_LEVEL")) {
+            for (unsigned i = 0U; i < (sizeof(names) / sizeof(names[0])); ++i) {
+                if (0 == ::strcasecmp(env, names[i])) {
+                    return static_cast<Level>(i);
+                }
+            }
+        }
+        return static_cast<Level>(ATLINK_LOG_LEVEL_DEFAULT);
+    }();
+    return level;
+}
+
+// Stands in for a Line below the compiled level; every insertion is a
+// no-op the compiler drops.
+class NullLine {
+  public:
+    template <typename T>
+    constexpr const NullLine &operator<<(const T &) const noexcept {
+        return *this;
+    }
+
+    constexpr void flush() const noexcept {}
+};
+
 } // namespace Log
 
 template <typename Backend>
@@ -67,7 +116,11 @@ class Logger {
     }
 
     bool wouldLog(Log::Level level) const {
-        return impl.wouldLog(level);
+        return Log::isCompiled(level) && impl.wouldLog(level);
+    }
+
+    const char *label() const {
+        return name;
     }
 
     class Line {
@@ -175,23 +228,33 @@ class Logger {
         }
     };
 
-    Line error() {
-        return Line{impl, name, Log::Level::Error};
+    auto error() {
+        return line<Log::Level::Error>();
     }
-    Line warn() {
-        return Line{impl, name, Log::Level::Warn};
+    auto warn() {
+        return line<Log::Level::Warn>();
     }
-    Line info() {
-        return Line{impl, name, Log::Level::Info};
+    auto info() {
+        return line<Log::Level::Info>();
     }
-    Line debug() {
-        return Line{impl, name, Log::Level::Debug};
+    auto debug() {
+        return line<Log::Level::Debug>();
     }
-    Line trace() {
-        return Line{impl, name, Log::Level::Trace};
+    auto trace() {
+        return line<Log::Level::Trace>();
+    }
+
+    template <Log::Level L>
+    auto line() {
+        if constexpr (Log::isCompiled(L)) {
+            return Line{impl, name, L};
+        } else {
+            return Log::NullLine{};
+        }
     }
 
   private:
+
     const char *name;
     Backend impl;
 };
@@ -0,0 +1,268 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/ChunkCursor.h"
+#include "atlink/platform/linux/Futex.h"
+#include "atlink/platform/linux/Logger.h"
+#include "atlink/platform/linux/MessageQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string_view>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Process-wide queue of log lines, written to stderr by a thread of its
+// own in batches of one writev. Logging threads only copy the line into
+// the ring; when it is full the line is dropped and counted, and the
+// count is reported once there is room again.
+class LogSink {
+  public:
+    using Level = typename ATL_NS::Platform::Api::Log::Level;
+
+    static constexpr std::size_t TextSize = 256U;
+    static constexpr std::size_t NameSize = 16U;
+    static constexpr std::size_t Capacity = 512U;
+    static constexpr std::size_t Batch = 64U;
+
+    static LogSink &instance() {
+        static LogSink sink;
+        return sink;
+    }
+
+    void post(Level lvl, const char *name, const char *data, std::size_t len);
+
+    uint64_t dropped() const {
+        return droppedTotal.load(std::memory_order_relaxed);
+    }
+
+  private:
+    // No member initialisers: the ring checks it while LogSink is incomplete.
+    struct Record {
+        timespec time;
+        Level level;
+        std::array<char, NameSize> name;
+        uint16_t length;
+        std::array<char, TextSize> text;
+    };
+
+    // Header text of one record in a batch.
+    struct Header {
+        std::array<char, 64U> data{};
+        std::size_t length{0U};
+    };
+
+    LogSink();
+    ~LogSink();
+
+    void loop();
+    std::size_t drain();
+    std::size_t header(Header &out, const Record &record);
+
+    MpscRing<Record, Capacity> ring;
+    alignas(64) std::atomic<uint32_t> sleeping{0U};
+    std::atomic<uint64_t> droppedTotal{0U};
+    uint64_t droppedReported{0U};
+    std::atomic<bool> run{true};
+    std::thread worker;
+
+    std::array<Record, Batch> batch{};
+    std::array<Header, Batch> headers{};
+    time_t cachedSecond{-1};
+    std::array<char, 16U> cachedStamp{};
+};
+
+// Logger backend handing lines to the LogSink, so a logging thread never
+// waits on the terminal.
+class AsyncLogger {
+  public:
+    using Level = typename ATL_NS::Platform::Api::Log::Level;
+
+    AsyncLogger()
+        : maxLevel(static_cast<unsigned>(Api::Log::initialLevel())), sink{LogSink::instance()} {}
+
+    void setLogLevel(Level lvl) {
+        maxLevel.store(static_cast<unsigned>(lvl), std::memory_order_release);
+    }
+    bool wouldLog(Level lvl) const {
+        return static_cast<unsigned>(lvl) <= maxLevel.load(std::memory_order_acquire);
+    }
+
+    void log(Level lvl, const char *name, const char *data, std::size_t len) {
+        sink.post(lvl, name, data, len);
+    }
+
+  private:
+    std::atomic<unsigned> maxLevel;
+    LogSink &sink;
+};
+
+inline LogSink::LogSink() : worker{&LogSink::loop, this} {}
+
+inline LogSink::~LogSink() {
+    run.store(false, std::memory_order_release);
+    sleeping.store(0U, std::memory_order_relaxed);
+    Futex::wake(sleeping, 1);
+    worker.join();
+}
+
+inline void LogSink::post(Level lvl, const char *name, const char *data, std::size_t len) {
+    Record record{};
+    ::clock_gettime(CLOCK_REALTIME, &record.time);
+    record.level = lvl;
+    if (nullptr != name) {
+        std::strncpy(record.name.data(), name, NameSize - 1U);
+    }
+    record.length = static_cast<uint16_t>((len < TextSize) ? len : TextSize);
+    if (nullptr != data) {
+        std::memcpy(record.text.data(), data, record.length);
+    }
+
+    if (!ring.tryPush(record)) {
+        droppedTotal.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((0U != sleeping.load(std::memory_order_relaxed)) &&
+        (1U == sleeping.exchange(0U, std::memory_order_relaxed))) {
+        Futex::wake(sleeping, 1);
+    }
+}
+
+inline void LogSink::loop() {
+    while (true) {
+        if (0U < drain())
+            continue;
+        if (!run.load(std::memory_order_acquire))
+            break;
+
+        sleeping.store(1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((0U < drain()) || !run.load(std::memory_order_acquire)) {
+            sleeping.store(0U, std::memory_order_relaxed);
+            continue;
+        }
+        Futex::wait(sleeping, 1U);
+    }
+}
+
+// Writes up to one batch, returns the number of lines taken.
+inline std::size_t LogSink::drain() {
+    std::size_t count = 0U;
+    while ((count < Batch) && ring.tryPop(batch[count])) {
+        ++count;
+    }
+
+    const uint64_t lost = droppedTotal.load(std::memory_order_relaxed) - droppedReported;
+    if ((0U == count) && (0U == lost))
+        return 0U;
+
+    static constexpr std::string_view Newline{"\n"};
+    static constexpr std::string_view Reset{Logger::ColorReset};
+    std::array<std::string_view, (Batch * 4U) + 1U> chunks;
+    std::size_t n = 0U;
+
+    for (std::size_t i = 0U; i < count; ++i) {
+        const Record &record = batch[i];
+        chunks[n++] = {headers[i].data.data(), header(headers[i], record)};
+        chunks[n++] = {record.text.data(), record.length};
+        if ('\0' != *Logger::levelColor(record.level)) {
+            chunks[n++] = Reset;
+        }
+        chunks[n++] = Newline;
+    }
+
+    std::array<char, 64U> notice{};
+    if (0U < lost) {
+        const int len = std::snprintf(
+            notice.data(), notice.size(), "[log] %llu lines dropped\n", (unsigned long long)lost);
+        chunks[n++] = {notice.data(), (0 < len) ? static_cast<std::size_t>(len) : 0U};
+        droppedReported += lost;
+    }
+
+    ChunkCursor cursor{{chunks.data(), n}};
+    std::array<iovec, 64U> iov;
+    while (true) {
+        const std::size_t entries = cursor.fill(iov);
+        if (0U == entries)
+            break;
+        const ssize_t written = ::writev(STDERR_FILENO, iov.data(), static_cast<int>(entries));
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        cursor.advance(static_cast<std::size_t>(written));
+    }
+
+    return (0U < count) ? count : 1U;
+}
+
+inline std::size_t LogSink::header(Header &out, const Record &record) {
+    if (record.time.tv_sec != cachedSecond) {
+        std::tm tm{};
+        localtime_r(&record.time.tv_sec, &tm);
+        std::snprintf(cachedStamp.data(),
+                      cachedStamp.size(),
+                      "%02d:%02d:%02d",
+                      tm.tm_hour,
+                      tm.tm_min,
+                      tm.tm_sec);
+        cachedSecond = record.time.tv_sec;
+    }
+
+    int len = 0;
+    if ('\0' != record.name[0]) {
+        len = std::snprintf(out.data.data(),
+                            out.data.size(),
+                            "%s[%s] %-5s [%s] ",
+                            Logger::levelColor(record.level),
+                            cachedStamp.data(),
+                            Logger::levelName(record.level),
+                            record.name.data());
+    } else {
+        len = std::snprintf(out.data.data(),
+                            out.data.size(),
+                            "%s[%s] %-5s ",
+                            Logger::levelColor(record.level),
+                            cachedStamp.data(),
+                            Logger::levelName(record.level));
+    }
+    out.length = (0 < len) ? std::min(static_cast<std::size_t>(len), out.data.size() - 1U) : 0U;
+    return out.length;
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
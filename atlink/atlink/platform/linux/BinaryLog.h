@@ -0,0 +1,151 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Binary log file mapped into memory, opened at the path in ATLINK_BLOG
+// and sized by ATLINK_BLOG_SIZE (MiB, 64 by default). Writers reserve
+// records with one fetch_add on the tail; once the file is full records
+// are dropped and counted. Without ATLINK_BLOG the log stays disabled and
+// lines are rendered as text. scripts/atlinklog decodes the file.
+class BinaryLog {
+  public:
+    // Layout of the first bytes of the file, records follow.
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t capacity;
+        std::atomic<uint64_t> tail; // bytes reserved, may run past capacity
+        std::atomic<uint64_t> dropped;
+        uint64_t reserved[3];
+    };
+    static_assert(64U == sizeof(FileHeader), "FileHeader is 64 bytes");
+
+    static constexpr char Magic[8] = {'A', 'T', 'L', 'B', 'L', 'O', 'G', '1'};
+    static constexpr uint32_t Version = 1U;
+    static constexpr std::size_t DefaultSizeMiB = 64U;
+
+    static BinaryLog &instance() {
+        static BinaryLog log;
+        return log;
+    }
+
+    bool enabled() const {
+        return nullptr != header;
+    }
+
+    // Space for a record of `bytes` (a multiple of 8), or nullptr if the
+    // file is full.
+    char *reserve(std::size_t bytes) {
+        const uint64_t at = header->tail.fetch_add(bytes, std::memory_order_relaxed);
+        if ((at + bytes) > header->capacity) {
+            header->dropped.fetch_add(1U, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return records + at;
+    }
+
+    uint64_t timestamp() const {
+        timespec ts{};
+        ::clock_gettime(CLOCK_REALTIME, &ts);
+        return (static_cast<uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    uint64_t dropped() const {
+        return enabled() ? header->dropped.load(std::memory_order_relaxed) : 0U;
+    }
+
+  private:
+    BinaryLog();
+    ~BinaryLog();
+
+    FileHeader *header{nullptr};
+    char *records{nullptr};
+    std::size_t mapped{0U};
+
+    // Disallow copy
+    BinaryLog(const BinaryLog &) = delete;
+    BinaryLog &operator=(const BinaryLog &) = delete;
+};
+
+inline BinaryLog::BinaryLog() {
+    const char *path = std::getenv("ATLINK_BLOG");
+    if ((nullptr == path) || ('\0' == *path))
+        return;
+
+    std::size_t sizeMiB = DefaultSizeMiB;
+    if (const char *env = std::getenv("ATLINK_BLOG_SIZE")) {
+        const unsigned long value = std::strtoul(env, nullptr, 10);
+        if (0U < value)
+            sizeMiB = value;
+    }
+    const std::size_t capacity = sizeMiB << 20U;
+    const std::size_t size = sizeof(FileHeader) + capacity;
+
+    // The file is sparse; only the records written take up disk space.
+    const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return;
+    void *base = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (MAP_FAILED == base)
+        return;
+
+    auto *file = new (base) FileHeader{};
+    for (std::size_t i = 0U; i < sizeof(Magic); ++i) {
+        file->magic[i] = Magic[i];
+    }
+    file->version = Version;
+    file->headerSize = sizeof(FileHeader);
+    file->capacity = capacity;
+
+    mapped = size;
+    records = static_cast<char *>(base) + sizeof(FileHeader);
+    header = file;
+}
+
+inline BinaryLog::~BinaryLog() {
+    // Left mapped: the kernel writes the pages back on exit, and threads
+    // still logging during static destruction keep a valid target.
+    if (nullptr != header) {
+        ::msync(header, mapped, MS_ASYNC);
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -0,0 +1,211 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <gsl/span>
+#include <new>
+#include <string_view>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Raw bytes exchanged with the device, kept in a ring file mapped into
+// memory. Enabled by ATLINK_CAPTURE, the path of the file, which is
+// allocated up front with ATLINK_CAPTURE_SIZE MiB (16 by default) of
+// ring; the oldest records are overwritten once it is full.
+//
+// The file starts with a 64 byte FileHeader. Records follow in the ring,
+// each a RecordHeader and the bytes, padded to 8. A record may wrap from
+// the end of the ring to its start. `head` counts every byte reserved
+// since the start, so the newest record ends at head % capacity, and
+// after a wrap the oldest one is found by scanning from there for the
+// sync word, which a writer stores last. scripts/atlinkcap turns the
+// ring into a pcap file.
+class CaptureTap {
+  public:
+    enum class Direction : uint8_t {
+        Rx = 0, // from the device
+        Tx = 1, // to the device
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t capacity;
+        std::atomic<uint64_t> head;
+        uint64_t reserved[4];
+    };
+    static_assert(64U == sizeof(FileHeader), "FileHeader is 64 bytes");
+
+    struct RecordHeader {
+        uint32_t sync;
+        uint32_t size; // header, bytes and padding
+        uint64_t time; // ns since the epoch
+        uint32_t length;
+        Direction direction;
+        uint8_t reserved[3];
+    };
+    static_assert(24U == sizeof(RecordHeader), "RecordHeader is 24 bytes");
+
+    static constexpr char Magic[8] = {'A', 'T', 'L', 'C', 'A', 'P', '0', '1'};
+    static constexpr uint32_t Version = 1U;
+    static constexpr uint32_t Sync = 0x43544C41U; // "ATLC"
+    static constexpr std::size_t DefaultSizeMiB = 16U;
+
+    static CaptureTap &instance() {
+        static CaptureTap tap;
+        return tap;
+    }
+
+    bool enabled() const {
+        return nullptr != header;
+    }
+
+    void record(Direction direction, std::string_view data) {
+        record(direction, gsl::span<const std::string_view>{&data, 1U}, data.size());
+    }
+
+    // Stores the first `length` bytes of the chunks.
+    void record(Direction direction, gsl::span<const std::string_view> chunks, std::size_t length);
+
+  private:
+    CaptureTap();
+    ~CaptureTap();
+
+    void copyIn(uint64_t position, const void *data, std::size_t length);
+
+    FileHeader *header{nullptr};
+    char *ring{nullptr};
+    uint64_t capacity{0U};
+    std::size_t mapped{0U};
+
+    // Disallow copy
+    CaptureTap(const CaptureTap &) = delete;
+    CaptureTap &operator=(const CaptureTap &) = delete;
+};
+
+inline CaptureTap::CaptureTap() {
+    const char *path = std::getenv("ATLINK_CAPTURE");
+    if ((nullptr == path) || ('\0' == *path))
+        return;
+
+    std::size_t sizeMiB = DefaultSizeMiB;
+    if (const char *env = std::getenv("ATLINK_CAPTURE_SIZE")) {
+        const unsigned long value = std::strtoul(env, nullptr, 10);
+        if (0U < value)
+            sizeMiB = value;
+    }
+    const std::size_t ringSize = sizeMiB << 20U;
+    const std::size_t size = sizeof(FileHeader) + ringSize;
+
+    // Allocated, not sparse: a full disk must not fault a writer later.
+    const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return;
+    void *base = MAP_FAILED;
+    if (::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0) {
+        base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (MAP_FAILED == base)
+        return;
+
+    auto *file = new (base) FileHeader{};
+    std::memcpy(file->magic, Magic, sizeof(Magic));
+    file->version = Version;
+    file->headerSize = sizeof(FileHeader);
+    file->capacity = ringSize;
+
+    mapped = size;
+    capacity = ringSize;
+    ring = static_cast<char *>(base) + sizeof(FileHeader);
+    header = file;
+}
+
+inline CaptureTap::~CaptureTap() {
+    // Left mapped, like the BinaryLog: the pages are written back on exit.
+    if (nullptr != header) {
+        ::msync(header, mapped, MS_ASYNC);
+    }
+}
+
+inline void CaptureTap::record(Direction direction,
+                               gsl::span<const std::string_view> chunks,
+                               std::size_t length) {
+    // A record never takes more than a quarter of the ring, so concurrent
+    // writers cannot lap each other.
+    const std::size_t limit = (capacity / 4U) - sizeof(RecordHeader);
+    if (length > limit)
+        length = limit;
+    const uint32_t size = static_cast<uint32_t>((sizeof(RecordHeader) + length + 7U) & ~7U);
+    const uint64_t position = header->head.fetch_add(size, std::memory_order_relaxed);
+
+    timespec ts{};
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    RecordHeader rec{};
+    rec.size = size;
+    rec.time = (static_cast<uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<uint64_t>(ts.tv_nsec);
+    rec.length = static_cast<uint32_t>(length);
+    rec.direction = direction;
+
+    // Records start 8 byte aligned, the sync word never wraps. It is
+    // cleared while the record is written and set when it is complete.
+    auto *sync = reinterpret_cast<std::atomic<uint32_t> *>(ring + (position % capacity));
+    sync->store(0U, std::memory_order_relaxed);
+
+    constexpr std::size_t skip = sizeof(rec.sync);
+    copyIn(position + skip, reinterpret_cast<const char *>(&rec) + skip, sizeof(rec) - skip);
+
+    uint64_t at = position + sizeof(rec);
+    for (const auto &chunk : chunks) {
+        if (0U == length)
+            break;
+        const std::size_t n = (chunk.size() < length) ? chunk.size() : length;
+        copyIn(at, chunk.data(), n);
+        at += n;
+        length -= n;
+    }
+
+    sync->store(Sync, std::memory_order_release);
+}
+
+inline void CaptureTap::copyIn(uint64_t position, const void *data, std::size_t length) {
+    const std::size_t offset = static_cast<std::size_t>(position % capacity);
+    const std::size_t first = (length < (capacity - offset)) ? length : (capacity - offset);
+    std::memcpy(ring + offset, data, first);
+    if (first < length) {
+        std::memcpy(ring, static_cast<const char *>(data) + first, length - first);
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
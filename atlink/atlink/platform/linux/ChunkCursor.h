@@ -0,0 +1,75 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <gsl/span>
+#include <string_view>
+#include <sys/uio.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Position in a list of chunks being written, to resume after a partial
+// write.
+class ChunkCursor {
+  public:
+    explicit ChunkCursor(gsl::span<const std::string_view> chunks) : chunks{chunks} {}
+
+    // Describes what is left in iov, returns the number of entries used.
+    template <size_t N>
+    size_t fill(std::array<iovec, N> &iov) const {
+        size_t count = 0U;
+        for (size_t i = index; (i < chunks.size()) && (count < N); ++i) {
+            const size_t skip = (i == index) ? offset : 0U;
+            if (skip < chunks[i].size()) {
+                iov[count].iov_base = const_cast<char *>(chunks[i].data() + skip);
+                iov[count].iov_len = chunks[i].size() - skip;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    void advance(size_t n) {
+        while ((0U < n) || ((index < chunks.size()) && (offset == chunks[index].size()))) {
+            const size_t remaining = chunks[index].size() - offset;
+            if (n < remaining) {
+                offset += n;
+                n = 0U;
+            } else {
+                n -= remaining;
+                ++index;
+                offset = 0U;
+            }
+        }
+    }
+
+  private:
+    gsl::span<const std::string_view> chunks;
+    size_t index{0U};
+    size_t offset{0U};
+};
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -0,0 +1,88 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/linux/Futex.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// A single state word: the waiter spins briefly, as the response often
+// arrives within microseconds, then parks on a futex. complete() only
+// enters the kernel if the waiter is parked.
+class Completion {
+  public:
+    Completion() = default;
+
+    // Non-copyable
+    Completion(const Completion &) = delete;
+    Completion &operator=(const Completion &) = delete;
+    Completion(Completion &&) = delete;
+    Completion &operator=(Completion &&) = delete;
+
+    void wait() {
+        // Spinning on a single core only delays the thread to complete.
+        static const unsigned spins = (1U < std::thread::hardware_concurrency()) ? SpinCount : 0U;
+        for (unsigned i = 0U; i < spins; ++i) {
+            if (Done == state.load(std::memory_order_acquire))
+                return;
+            relax();
+        }
+
+        uint32_t expected = Pending;
+        if (state.compare_exchange_strong(expected, Parked, std::memory_order_acquire)) {
+            expected = Parked;
+        }
+        while (Done != expected) {
+            Futex::wait(state, Parked);
+            expected = state.load(std::memory_order_acquire);
+        }
+    }
+
+    void complete() {
+        if (Parked == state.exchange(Done, std::memory_order_release)) {
+            Futex::wake(state, 1);
+        }
+    }
+
+  private:
+    static constexpr uint32_t Pending = 0U;
+    static constexpr uint32_t Done = 1U;
+    static constexpr uint32_t Parked = 2U;
+    static constexpr unsigned SpinCount = 128U;
+
+    static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#endif
+    }
+
+    std::atomic<uint32_t> state{Pending};
+};
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
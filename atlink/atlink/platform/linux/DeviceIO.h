@@ -20,20 +20,16 @@
 #include "atlink/platform/api/DeviceIO.h"
 
 #include "atlink/platform/api/Logger.h"
-#include "atlink/platform/linux/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/Tty.h"
 
 #include <atomic>
-#include <cerrno>
 #include <cstddef>
-#include <cstdlib>
-#include <cstring>
-#include <fcntl.h>
+#include <cstdint>
 #include <gsl/span>
 #include <poll.h>
 #include <string_view>
-#include <termios.h>
 #include <thread>
-#include <unistd.h>
 
 namespace ATL_NS {
 namespace Platform {
@@ -42,25 +38,23 @@ namespace Linux {
 
 class DeviceIO {
   public:
-    DeviceIO();
+    explicit DeviceIO(const Api::SerialConfig &config = {});
     ~DeviceIO();
     using Subscriber = ATL_NS::Platform::Api::Subscriber;
     void subscribe(Subscriber &l);
 
     size_t write(std::string_view s);
+    size_t write(gsl::span<const std::string_view> chunks);
     size_t read(gsl::span<char> buf);
+    bool setBaudRate(uint32_t baud);
 
   private:
-    int fd{-1};
+    Api::Logger<Linux::AsyncLogger> logger;
+    Tty tty;
     std::thread poller;
     std::atomic<bool> run{false};
     std::atomic<Subscriber *> subscriber{nullptr};
 
-    Api::Logger<Linux::Logger> logger;
-
-    int openAndConfigureTty();
-    void print(const char *prefix, const std::string_view str);
-
     void pollLoop();
     void notifyRx();
 
@@ -69,12 +63,11 @@ class DeviceIO {
     DeviceIO &operator=(const DeviceIO &) = delete;
 };
 
-inline DeviceIO::DeviceIO() : logger{"deviceio"} {
-    fd = openAndConfigureTty();
-    if (fd >= 0) {
+inline DeviceIO::DeviceIO(const Api::SerialConfig &config)
+    : logger{"deviceio"}, tty{logger, config} {
+    if (tty.open()) {
         run = true;
         poller = std::thread(&DeviceIO::pollLoop, this);
-        logger.setLogLevel(Api::Log::Level::Trace);
         logger.info() << "poller thread started";
     } else {
         logger.error() << "DeviceIO initialization failed";
@@ -85,8 +78,7 @@ inline DeviceIO::~DeviceIO() {
     run = false;
     if (poller.joinable())
         poller.join();
-    if (fd >= 0)
-        ::close(fd);
+    tty.close();
     logger.info() << "device closed";
 }
 
@@ -96,43 +88,19 @@ inline void DeviceIO::subscribe(Subscriber &s) {
 }
 
 inline size_t DeviceIO::write(std::string_view s) {
-    if (fd < 0 || s.empty())
-        return 0;
-
-    print("deviceio-tx", s);
-
-    ssize_t n = ::write(fd, s.data(), s.size());
-    if (n < 0) {
-        logger.error() << "write failed: " << strerror(errno);
-        return 0;
-    }
+    return tty.write(gsl::span<const std::string_view>{&s, 1U});
+}
 
-    logger.trace() << "tx complete (" << n << " bytes)";
-    return static_cast<size_t>(n);
+inline size_t DeviceIO::write(gsl::span<const std::string_view> chunks) {
+    return tty.write(chunks);
 }
 
 inline size_t DeviceIO::read(gsl::span<char> buf) {
-    if (fd < 0 || buf.empty())
-        return 0;
-
-    // Use ssize_t to capture -1 correctly.
-    ssize_t r = ::read(fd, buf.data(), buf.size());
-    if (r < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            // No data available right now
-            return 0;
-        }
-        logger.error() << "read failed: " << strerror(errno);
-        return 0;
-    }
-
-    const size_t len = static_cast<size_t>(r);
-
-    // Log rx contents for debugging/trace
-    print("deviceio-rx", {buf.data(), len});
+    return tty.read(buf);
+}
 
-    logger.trace() << "rx read " << len << " bytes";
-    return len;
+inline bool DeviceIO::setBaudRate(uint32_t baud) {
+    return tty.setBaudRate(baud);
 }
 
 inline void DeviceIO::notifyRx() {
@@ -141,85 +109,12 @@ inline void DeviceIO::notifyRx() {
     }
 }
 
-inline int DeviceIO::openAndConfigureTty() {
-    const char *path = std::getenv("ATLINK_TTY");
-    if (!path) {
-        path = "/dev/ttyUSB0";
-        logger.warn() << "ATLINK_TTY not set; defaulting to /dev/ttyUSB0";
-    }
-
-    int fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (fd < 0) {
-        logger.error() << "open(\"" << path << "\") failed: " << strerror(errno);
-        return -1;
-    }
-
-    termios tio{};
-    if (tcgetattr(fd, &tio) != 0) {
-        logger.error() << "tcgetattr failed: " << strerror(errno);
-        ::close(fd);
-        return -1;
-    }
-
-    cfmakeraw(&tio);
-    cfsetispeed(&tio, B115200);
-    cfsetospeed(&tio, B115200);
-
-    tio.c_cflag |= (CLOCAL | CREAD);
-    tio.c_cflag &= ~PARENB;
-    tio.c_cflag &= ~CSTOPB;
-    tio.c_cflag &= ~CSIZE;
-    tio.c_cflag |= CS8;
-
-    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
-        logger.error() << "tcsetattr failed: " << strerror(errno);
-        ::close(fd);
-        return -1;
-    }
-
-    logger.info() << "TTY opened and configured (" << path << ")";
-    return fd;
-}
-
-inline void DeviceIO::print(const char *prefix, const std::string_view str) {
-
-    // Raw summary (length)
-    logger.trace() << prefix << ": len=" << str.size();
-
-    if (str.empty()) {
-        return;
-    }
-
-    // Build an escaped, printable representation: <CR>, <LF>, other chars copied.
-    std::string out;
-    out.reserve(str.size() * 2 + 16);
-    out.append("data=");
-
-    for (unsigned char c : str) {
-        if (c == '\r')
-            out.append("<CR>");
-        else if (c == '\n')
-            out.append("<LF>");
-        else if (c >= 32 && c < 127)
-            out.push_back(static_cast<char>(c));
-        else {
-            // Non-printable: hex escape
-            char buf[8];
-            int n = snprintf(buf, sizeof(buf), "<0x%02X>", c);
-            if (n > 0)
-                out.append(buf, static_cast<size_t>(n));
-        }
-    }
-
-    logger.debug() << out.c_str();
-}
-
 inline void DeviceIO::pollLoop() {
-    if (fd < 0)
+    if (tty.handle() < 0)
         return;
 
     struct pollfd pfd;
-    pfd.fd = fd;
+    pfd.fd = tty.handle();
     pfd.events = POLLIN;
     pfd.revents = 0;
 
@@ -0,0 +1,126 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/api/DeviceIO.h"
+
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/Reactor.h"
+#include "atlink/platform/linux/Tty.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/span>
+#include <string_view>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// DeviceIO backend whose tty is watched by the shared Reactor instead of a
+// poller thread of its own. Destruction returns at once.
+class EpollDeviceIO : private Reactor::Handler {
+  public:
+    explicit EpollDeviceIO(const Api::SerialConfig &config = {});
+    ~EpollDeviceIO();
+    using Subscriber = ATL_NS::Platform::Api::Subscriber;
+    void subscribe(Subscriber &l);
+
+    size_t write(std::string_view s);
+    size_t write(gsl::span<const std::string_view> chunks);
+    size_t read(gsl::span<char> buf);
+    bool setBaudRate(uint32_t baud);
+
+  private:
+    Api::Logger<Linux::AsyncLogger> logger;
+    Tty tty;
+    bool registered{false};
+    std::atomic<Subscriber *> subscriber{nullptr};
+
+    void onReadable() override;
+    void notifyRx();
+
+    // Disallow copy
+    EpollDeviceIO(const EpollDeviceIO &) = delete;
+    EpollDeviceIO &operator=(const EpollDeviceIO &) = delete;
+};
+
+inline EpollDeviceIO::EpollDeviceIO(const Api::SerialConfig &config)
+    : logger{"deviceio"}, tty{logger, config} {
+    if (tty.open()) {
+        registered = Reactor::instance().add(tty.handle(), *this);
+    }
+    if (!registered) {
+        logger.error() << "DeviceIO initialization failed";
+    }
+}
+
+inline EpollDeviceIO::~EpollDeviceIO() {
+    if (registered) {
+        Reactor::instance().remove(tty.handle());
+    }
+    tty.close();
+    logger.info() << "device closed";
+}
+
+inline void EpollDeviceIO::subscribe(Subscriber &s) {
+    subscriber.store(&s, std::memory_order_release);
+    logger.debug() << "subscriber registered";
+    // Input that arrived before has not been announced to anyone.
+    notifyRx();
+}
+
+inline size_t EpollDeviceIO::write(std::string_view s) {
+    return tty.write(gsl::span<const std::string_view>{&s, 1U});
+}
+
+inline size_t EpollDeviceIO::write(gsl::span<const std::string_view> chunks) {
+    return tty.write(chunks);
+}
+
+inline size_t EpollDeviceIO::read(gsl::span<char> buf) {
+    const auto n = tty.read(buf);
+    // Readiness is edge-triggered: if the buffer was filled up, more input
+    // may be pending that no new edge will announce.
+    if ((0U < n) && (n == buf.size())) {
+        notifyRx();
+    }
+    return n;
+}
+
+inline bool EpollDeviceIO::setBaudRate(uint32_t baud) {
+    return tty.setBaudRate(baud);
+}
+
+inline void EpollDeviceIO::onReadable() {
+    logger.trace() << "epoll: EPOLLIN";
+    notifyRx();
+}
+
+inline void EpollDeviceIO::notifyRx() {
+    if (auto *sub = subscriber.load(std::memory_order_acquire)) {
+        sub->notify(Subscriber::Event::RxReady);
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -0,0 +1,62 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Thin wrappers over the futex syscall for process-private words.
+namespace Futex {
+
+// Sleeps while word holds expected. Returns early on any wake, signal or
+// change of the word; callers re-check their condition.
+inline void wait(std::atomic<uint32_t> &word, uint32_t expected) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word size");
+    (void)::syscall(SYS_futex,
+                    reinterpret_cast<uint32_t *>(&word),
+                    FUTEX_WAIT_PRIVATE,
+                    expected,
+                    nullptr,
+                    nullptr,
+                    0);
+}
+
+inline void wake(std::atomic<uint32_t> &word, int count = INT_MAX) {
+    (void)::syscall(SYS_futex,
+                    reinterpret_cast<uint32_t *>(&word),
+                    FUTEX_WAKE_PRIVATE,
+                    count,
+                    nullptr,
+                    nullptr,
+                    0);
+}
+
+} // namespace Futex
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
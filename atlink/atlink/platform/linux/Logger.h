@@ -32,7 +32,7 @@ class Logger {
   public:
     using Level = typename ATL_NS::Platform::Api::Log::Level;
 
-    Logger() : maxLevel(static_cast<unsigned>(Level::Info)) {}
+    Logger() : maxLevel(static_cast<unsigned>(Api::Log::initialLevel())) {}
 
     void setLogLevel(Level lvl) {
         maxLevel.store(static_cast<unsigned>(lvl), std::memory_order_release);
@@ -51,28 +51,8 @@ class Logger {
 
         const char *lv = levelName(lvl);
 
-        // Select color based on severity
-        static constexpr const char *COLOR_GREEN = "\033[32m";
-        static constexpr const char *COLOR_RED = "\033[31m";
-        static constexpr const char *COLOR_YELLOW = "\033[33m";
-        static constexpr const char *COLOR_RESET = "\033[0m";
-
-        const char *color = "";
-        const char *reset = COLOR_RESET;
-
-        switch (lvl) {
-        case Level::Error:
-            color = COLOR_RED;
-            break;
-        case Level::Warn:
-            color = COLOR_YELLOW;
-            break;
-        case Level::Debug:
-            color = COLOR_GREEN;
-            break;
-        default:
-            break;
-        }
+        const char *color = levelColor(lvl);
+        const char *reset = ColorReset;
 
         // Print header with color
         std::fprintf(stderr, "%s[%s] %-5s", color, ts, lv);
@@ -95,7 +75,22 @@ class Logger {
         std::fflush(stderr);
     }
 
-  private:
+    static constexpr const char *ColorReset = "\033[0m";
+
+    // Severity colour, or an empty string for plain lines.
+    static const char *levelColor(Level lvl) {
+        switch (lvl) {
+        case Level::Error:
+            return "\033[31m";
+        case Level::Warn:
+            return "\033[33m";
+        case Level::Debug:
+            return "\033[32m";
+        default:
+            return "";
+        }
+    }
+
     static const char *levelName(Level lvl) {
         switch (lvl) {
         case Level::Error:
@@ -112,6 +107,7 @@ class Logger {
         return "LOG";
     }
 
+  private:
     std::atomic<unsigned> maxLevel;
 };
 
@@ -14,12 +14,15 @@
 //  You should have received a copy of the GNU General Public License
 //  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
 //
-
 #pragma once
 
-#include <condition_variable>
-#include <deque>
-#include <mutex>
+#include "atlink/platform/linux/Futex.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 
 namespace ATL_NS {
@@ -27,41 +30,154 @@ namespace Platform {
 namespace Impl {
 namespace Linux {
 
-template <typename T>
+// Bounded ring for many producers and one consumer, after Dmitry Vyukov's
+// MPMC queue: every cell carries a sequence number telling whose turn it is,
+// so producers only contend on the tail index.
+template <typename T, std::size_t Capacity>
+class MpscRing {
+    static_assert((1U < Capacity) && (0U == (Capacity & (Capacity - 1U))),
+                  "Capacity must be a power of two");
+    static_assert(std::is_default_constructible<T>::value && std::is_move_assignable<T>::value,
+                  "T must be default-constructible and move-assignable");
+
+  public:
+    MpscRing() {
+        for (std::size_t i = 0U; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(T &msg) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &cells[pos & (Capacity - 1U)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (0 == diff) {
+                if (tail.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(msg);
+        cell->sequence.store(pos + 1U, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    bool tryPop(T &out) {
+        Cell &cell = cells[head & (Capacity - 1U)];
+        const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != head + 1U)
+            return false;
+        out = std::move(cell.value);
+        cell.sequence.store(head + Capacity, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    // Consumer only; exact unless a push is in progress.
+    std::size_t size() const {
+        return tail.load(std::memory_order_relaxed) - head;
+    }
+
+  private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0U};
+        T value{};
+    };
+
+    std::array<Cell, Capacity> cells;
+    alignas(64) std::atomic<std::size_t> tail{0U};
+    alignas(64) std::size_t head{0U};
+};
+
+// Lock-free hand-off to the single thread calling get(). The consumer
+// parks on a futex only when both lanes are empty, and producers park only
+// while the ring is full, so the common put() is one CAS and a load.
+// Messages put to the front overtake all others, but keep their order
+// among themselves.
+template <typename T, std::size_t Capacity = 256U>
 class MessageQueue {
   public:
     MessageQueue() = default;
 
     void put(T msg) {
-        {
-            std::lock_guard<std::mutex> lk(mutex);
-            queue.push_back(std::move(msg));
-        }
-        condvar.notify_one();
+        push(queue, msg);
     }
 
     void putFront(T msg) {
-        {
-            std::lock_guard<std::mutex> lk(mutex);
-            queue.push_front(std::move(msg));
-        }
-        condvar.notify_one();
+        push(urgent, msg);
     }
 
     T get() {
-        std::unique_lock<std::mutex> lk(mutex);
-        condvar.wait(lk, [this] {
-            return !queue.empty();
-        });
-        T v = std::move(queue.front());
-        queue.pop_front();
-        return v;
+        T msg{};
+        while (!pop(msg)) {
+            sleeping.store(1U, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (pop(msg)) {
+                sleeping.store(0U, std::memory_order_relaxed);
+                break;
+            }
+            Futex::wait(sleeping, 1U);
+        }
+        return msg;
     }
 
+    // Non-copyable
+    MessageQueue(const MessageQueue &) = delete;
+    MessageQueue &operator=(const MessageQueue &) = delete;
+
   private:
-    mutable std::mutex mutex;
-    std::condition_variable condvar;
-    std::deque<T> queue;
+    static constexpr std::size_t UrgentCapacity = 16U;
+
+    template <std::size_t N>
+    void push(MpscRing<T, N> &ring, T &msg) {
+        while (!ring.tryPush(msg)) {
+            const uint32_t seen = space.load(std::memory_order_acquire);
+            blocked.fetch_add(1U, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool pushed = ring.tryPush(msg);
+            if (!pushed) {
+                Futex::wait(space, seen);
+            }
+            blocked.fetch_sub(1U, std::memory_order_relaxed);
+            if (pushed)
+                break;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (0U != sleeping.load(std::memory_order_relaxed)) {
+            if (1U == sleeping.exchange(0U, std::memory_order_relaxed)) {
+                Futex::wake(sleeping, 1);
+            }
+        }
+    }
+
+    bool pop(T &msg) {
+        if (!urgent.tryPop(msg) && !queue.tryPop(msg))
+            return false;
+
+        // Blocked producers are let go once half the ring is free, not one
+        // syscall per message.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((0U != blocked.load(std::memory_order_relaxed)) &&
+            (urgent.size() <= (UrgentCapacity / 2U)) && (queue.size() <= (Capacity / 2U))) {
+            space.fetch_add(1U, std::memory_order_release);
+            Futex::wake(space);
+        }
+        return true;
+    }
+
+    MpscRing<T, Capacity> queue;
+    MpscRing<T, UrgentCapacity> urgent;
+    alignas(64) std::atomic<uint32_t> sleeping{0U};
+    alignas(64) std::atomic<uint32_t> space{0U};
+    std::atomic<uint32_t> blocked{0U};
 };
 
 } // namespace Linux
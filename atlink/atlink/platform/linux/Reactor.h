@@ -0,0 +1,188 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// One epoll instance and thread serving the ttys of all devices, so a
+// batch of readiness costs a single syscall however many modems there are.
+// An eventfd wakes the thread at once, e.g. to shut it down. The thread
+// lives as long as the reactor and sleeps in epoll_wait while no fd is
+// registered, so devices coming and going never start or join it.
+class Reactor {
+  public:
+    class Handler {
+      public:
+        virtual void onReadable() = 0;
+        virtual ~Handler() = default;
+    };
+
+    // Events taken per epoll_wait; more ready fds are left for the next.
+    static constexpr std::size_t Batch = 64U;
+
+    static Reactor &instance() {
+        static Reactor reactor;
+        return reactor;
+    }
+
+    // Edge-triggered: the handler is called when new input arrives, not
+    // while unread input is pending.
+    bool add(int fd, Handler &handler);
+
+    // Once it returns, the handler of fd is not called anymore. Must not be
+    // called from a handler.
+    void remove(int fd);
+
+    void wake();
+
+  private:
+    Reactor();
+    ~Reactor();
+
+    void loop();
+
+    Api::Logger<Linux::AsyncLogger> logger;
+    int epfd{-1};
+    int evfd{-1};
+    std::mutex mtx;
+    // Looked up by fd rather than carried in the event, so an event still
+    // pending for a removed fd finds no handler.
+    std::unordered_map<int, Handler *> handlers;
+    std::thread worker;
+    std::atomic<bool> run{false};
+
+    // Disallow copy
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+};
+
+inline Reactor::Reactor() : logger{"reactor"} {
+    epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    evfd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((epfd < 0) || (evfd < 0)) {
+        logger.error() << "epoll setup failed: " << strerror(errno);
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = evfd;
+    if (::epoll_ctl(epfd, EPOLL_CTL_ADD, evfd, &ev) != 0) {
+        logger.error() << "epoll_ctl(eventfd) failed: " << strerror(errno);
+        return;
+    }
+
+    run.store(true, std::memory_order_release);
+    worker = std::thread(&Reactor::loop, this);
+}
+
+inline Reactor::~Reactor() {
+    run.store(false, std::memory_order_release);
+    wake();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (evfd >= 0)
+        ::close(evfd);
+    if (epfd >= 0)
+        ::close(epfd);
+}
+
+inline bool Reactor::add(int fd, Handler &handler) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (!run.load(std::memory_order_acquire)) {
+        logger.error() << "cannot register fd " << fd;
+        return false;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = fd;
+    if (::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        logger.error() << "epoll_ctl(add) failed: " << strerror(errno);
+        return false;
+    }
+
+    handlers[fd] = &handler;
+    logger.debug() << "fd " << fd << " registered";
+    return true;
+}
+
+inline void Reactor::remove(int fd) {
+    // The handlers are called with the lock held, so none of fd's can be
+    // running past this point.
+    std::lock_guard<std::mutex> lk(mtx);
+    (void)::epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+    handlers.erase(fd);
+}
+
+inline void Reactor::wake() {
+    const uint64_t one = 1U;
+    (void)!::write(evfd, &one, sizeof(one));
+}
+
+inline void Reactor::loop() {
+    std::array<epoll_event, Batch> events;
+
+    while (run.load(std::memory_order_acquire)) {
+        int n = ::epoll_wait(epfd, events.data(), static_cast<int>(events.size()), -1);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            logger.error() << "epoll_wait failed: " << strerror(errno);
+            break;
+        }
+
+        std::lock_guard<std::mutex> lk(mtx);
+        for (int i = 0; i < n; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == evfd) {
+                uint64_t value = 0U;
+                (void)!::read(evfd, &value, sizeof(value));
+            } else {
+                const auto it = handlers.find(fd);
+                if (handlers.end() != it) {
+                    it->second->onReadable();
+                }
+            }
+        }
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -14,81 +14,94 @@
 //  You should have received a copy of the GNU General Public License
 //  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
 //
-
 #pragma once
 
+#include "atlink/utils/TimingWheel.h"
+
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <ctime>
 #include <mutex>
+#include <sys/timerfd.h>
 #include <thread>
+#include <unistd.h>
 
 namespace ATL_NS {
 namespace Platform {
 namespace Impl {
 namespace Linux {
 
-class Timer {
+class Timer;
+
+// Runs the timers of the process on one thread, in a timing wheel of
+// millisecond ticks. A timerfd is armed for the next tick with work, so
+// the thread sleeps while no timer is due. Callbacks run on that thread.
+class TimerService {
+  public:
+    using Wheel = ATL_NS::Utils::TimingWheel<4U>;
+    using Duration = std::chrono::steady_clock::duration;
+
+    static TimerService &instance() {
+        static TimerService service;
+        return service;
+    }
+
+    void start(Timer &timer, Duration d);
+    void stop(Timer &timer);
+
+  private:
+    TimerService();
+    ~TimerService();
+
+    uint64_t nowTicks() const;
+    void rearm();
+    void arm(uint64_t tick);
+    void loop();
+
+    int tfd{-1};
+    timespec epoch{};
+    Wheel wheel{0U};
+    uint64_t armed{Wheel::Never};
+    Timer *firing{nullptr};
+    bool run{true};
+    std::mutex mtx;
+    std::condition_variable idle;
+    std::thread worker;
+
+    // Disallow copy
+    TimerService(const TimerService &) = delete;
+    TimerService &operator=(const TimerService &) = delete;
+};
+
+class Timer : private TimerService::Wheel::Node {
   public:
     using Callback = void (*)(void *);
     using Clock = std::chrono::steady_clock;
     using Duration = Clock::duration;
 
-    Timer() = default;
+    // Makes sure the service outlives every timer.
+    Timer() : service{TimerService::instance()} {}
 
     ~Timer() {
         stop();
     }
 
     void setHandler(Callback cb, void *user) {
-        std::lock_guard<std::mutex> lk(mutex);
-        callback = cb;
-        context = user;
+        callback.store(cb, std::memory_order_relaxed);
+        context.store(user, std::memory_order_release);
     }
 
     void start(Duration d) {
-        stop();
-        {
-            std::lock_guard<std::mutex> lk(mutex);
-            stopFlag = false;
-            running.store(true, std::memory_order_release);
-            ++generation; // bump generation to invalidate old waits
-        }
-        const auto gen = generation.load(std::memory_order_acquire);
-
-        worker = std::thread([this, d, gen]() {
-            std::unique_lock<std::mutex> lk(mutex);
-            // Wait until timeout or canceled/restarted (generation change)
-            bool canceled = condvar.wait_for(lk, d, [this, gen] {
-                return stopFlag || gen != generation.load(std::memory_order_acquire);
-            });
-            if (!canceled) {
-                // Fire outside the lock to avoid handler-induced deadlocks
-                auto cb = callback;
-                auto ctx = context;
-                lk.unlock();
-                if (cb)
-                    cb(ctx);
-                lk.lock();
-            }
-            running.store(false, std::memory_order_release);
-        });
+        service.start(*this, d);
     }
 
+    // Once it returns, the callback is not running, unless stop() is
+    // called from the callback itself.
     void stop() {
-        {
-            std::lock_guard<std::mutex> lk(mutex);
-            if (!running.load(std::memory_order_acquire)) {
-                // nothing to do
-            } else {
-                stopFlag = true;
-                ++generation;
-                condvar.notify_all();
-            }
-        }
-        if (worker.joinable())
-            worker.join();
-        running.store(false, std::memory_order_release);
+        service.stop(*this);
     }
 
     bool isRunning() const {
@@ -100,20 +113,118 @@ class Timer {
     Timer &operator=(const Timer &) = delete;
 
   private:
-    Callback callback{nullptr};
-    void *context{nullptr};
-    bool stopFlag{false};
-
-    // generation helps cancel/restart without racing the waiter
-    std::atomic<uint64_t> generation{0};
+    friend class TimerService;
 
+    TimerService &service;
+    std::atomic<Callback> callback{nullptr};
+    std::atomic<void *> context{nullptr};
     std::atomic<bool> running{false};
-    std::thread worker;
-    mutable std::mutex mutex;
-    std::condition_variable condvar;
 };
 
+inline TimerService::TimerService() {
+    ::clock_gettime(CLOCK_MONOTONIC, &epoch);
+    tfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    worker = std::thread(&TimerService::loop, this);
+}
+
+inline TimerService::~TimerService() {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        run = false;
+        arm(0U);
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (tfd >= 0) {
+        ::close(tfd);
+    }
+}
+
+inline void TimerService::start(Timer &timer, Duration d) {
+    std::lock_guard<std::mutex> lk(mtx);
+    // Rounded up, so a timer never fires early.
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(d);
+    const uint64_t ticks = (0 < ms.count()) ? static_cast<uint64_t>(ms.count()) : 0U;
+    wheel.insert(timer, nowTicks() + ticks + 1U);
+    timer.running.store(true, std::memory_order_release);
+    rearm();
+}
+
+inline void TimerService::stop(Timer &timer) {
+    std::unique_lock<std::mutex> lk(mtx);
+    wheel.remove(timer);
+    if (std::this_thread::get_id() != worker.get_id()) {
+        idle.wait(lk, [this, &timer] { return firing != &timer; });
+    }
+    timer.running.store(false, std::memory_order_release);
+}
+
+inline uint64_t TimerService::nowTicks() const {
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    const int64_t ns = (static_cast<int64_t>(now.tv_sec) - epoch.tv_sec) * 1000000000LL +
+                       (now.tv_nsec - epoch.tv_nsec);
+    return static_cast<uint64_t>(ns / 1000000LL);
+}
+
+inline void TimerService::rearm() {
+    const uint64_t next = wheel.nextEvent();
+    if (next < armed) {
+        arm(next);
+    }
+}
+
+// Tick 0 lies in the past and fires at once.
+inline void TimerService::arm(uint64_t tick) {
+    armed = tick;
+    itimerspec spec{};
+    if (Wheel::Never != tick) {
+        const int64_t ns = epoch.tv_nsec + static_cast<int64_t>(tick % 1000U) * 1000000LL;
+        spec.it_value.tv_sec = epoch.tv_sec + static_cast<time_t>(tick / 1000U) +
+                               static_cast<time_t>(ns / 1000000000LL);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000LL);
+    }
+    (void)::timerfd_settime(tfd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+inline void TimerService::loop() {
+    while (true) {
+        uint64_t expirations = 0U;
+        const ssize_t n = ::read(tfd, &expirations, sizeof(expirations));
+        if ((n < 0) && (errno != EINTR)) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lk(mtx);
+        if (!run) {
+            break;
+        }
+        armed = Wheel::Never;
+        wheel.advance(nowTicks());
+
+        while (auto *node = wheel.popExpired()) {
+            auto &timer = static_cast<Timer &>(*node);
+            const auto cb = timer.callback.load(std::memory_order_relaxed);
+            auto *ctx = timer.context.load(std::memory_order_acquire);
+            firing = &timer;
+            lk.unlock();
+            if (cb) {
+                cb(ctx);
+            }
+            lk.lock();
+            // Unless the callback restarted it.
+            if (!timer.linked()) {
+                timer.running.store(false, std::memory_order_release);
+            }
+            firing = nullptr;
+            idle.notify_all();
+        }
+        rearm();
+    }
+}
+
 } // namespace Linux
 } // namespace Impl
 } // namespace Platform
-} // namespace ATL_NS
\ No newline at end of file
+} // namespace ATL_NS
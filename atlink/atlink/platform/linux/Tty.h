@@ -0,0 +1,389 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/platform/api/BinaryLog.h"
+#include "atlink/platform/api/DeviceIO.h"
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/BinaryLog.h"
+#include "atlink/platform/linux/CaptureTap.h"
+#include "atlink/platform/linux/ChunkCursor.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <gsl/span>
+#include <linux/serial.h>
+#include <poll.h>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// Non-blocking raw tty shared by the DeviceIO backends, set up from a
+// SerialConfig. The device is taken from ATLINK_TTY unless the config
+// names one.
+class Tty {
+  public:
+    explicit Tty(Api::Logger<Linux::AsyncLogger> &logger, const Api::SerialConfig &config = {})
+        : logger{logger}, config{config} {}
+    ~Tty() {
+        close();
+    }
+
+    bool open();
+    void close();
+
+    // The tty is opened non-blocking; io_uring needs it blocking to park
+    // reads in the kernel instead of failing them with EAGAIN.
+    bool setNonBlocking(bool enabled);
+
+    int handle() const {
+        return fd;
+    }
+
+    size_t write(gsl::span<const std::string_view> chunks);
+    size_t read(gsl::span<char> buf);
+
+    // Waits for pending output to be sent, then switches the rate.
+    bool setBaudRate(uint32_t baud);
+
+  private:
+    int fd{-1};
+    Api::Logger<Linux::AsyncLogger> &logger;
+    Api::SerialConfig config;
+    CaptureTap &tap{CaptureTap::instance()};
+
+    // struct termios2 of the kernel, which takes any rate with BOTHER.
+    // glibc's termios has no room for it, and <asm/termbits.h> clashes
+    // with <termios.h>.
+    struct Termios2 {
+        tcflag_t c_iflag;
+        tcflag_t c_oflag;
+        tcflag_t c_cflag;
+        tcflag_t c_lflag;
+        cc_t c_line;
+        cc_t c_cc[19];
+        speed_t c_ispeed;
+        speed_t c_ospeed;
+    };
+
+    // Upper bound for a blocked transmitter, e.g. on hardware flow control.
+    static constexpr int writeTimeoutMs = 1000;
+
+    bool configure();
+    bool applySpeed(const termios &tio, uint32_t baud);
+    void setLowLatency();
+    bool waitWritable();
+    void print(const char *prefix, const std::string_view str);
+
+    static speed_t standardSpeed(uint32_t baud);
+
+    // Disallow copy
+    Tty(const Tty &) = delete;
+    Tty &operator=(const Tty &) = delete;
+};
+
+inline bool Tty::open() {
+    const char *path = (nullptr != config.port) ? config.port : std::getenv("ATLINK_TTY");
+    if (!path) {
+        path = "/dev/ttyUSB0";
+        logger.warn() << "ATLINK_TTY not set; defaulting to /dev/ttyUSB0";
+    }
+
+    fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        logger.error() << "open(\"" << path << "\") failed: " << strerror(errno);
+        return false;
+    }
+
+    if (!configure()) {
+        close();
+        return false;
+    }
+
+    logger.info() << "TTY opened and configured (" << path << ", " << config.baudRate << " baud"
+                  << ((Api::SerialConfig::FlowControl::RtsCts == config.flowControl) ? ", RTS/CTS"
+                                                                                     : "")
+                  << ")";
+    return true;
+}
+
+inline bool Tty::configure() {
+    termios tio{};
+    if (tcgetattr(fd, &tio) != 0) {
+        logger.error() << "tcgetattr failed: " << strerror(errno);
+        return false;
+    }
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= (CLOCAL | CREAD);
+    tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+
+    switch (config.dataBits) {
+    case 5U:
+        tio.c_cflag |= CS5;
+        break;
+    case 6U:
+        tio.c_cflag |= CS6;
+        break;
+    case 7U:
+        tio.c_cflag |= CS7;
+        break;
+    default:
+        tio.c_cflag |= CS8;
+        break;
+    }
+    if (Api::SerialConfig::Parity::None != config.parity) {
+        tio.c_cflag |= PARENB;
+        if (Api::SerialConfig::Parity::Odd == config.parity)
+            tio.c_cflag |= PARODD;
+    }
+    if (2U == config.stopBits) {
+        tio.c_cflag |= CSTOPB;
+    }
+    if (Api::SerialConfig::FlowControl::RtsCts == config.flowControl) {
+        tio.c_cflag |= CRTSCTS;
+    }
+
+    if (!applySpeed(tio, config.baudRate))
+        return false;
+
+    if (config.lowLatency) {
+        setLowLatency();
+    }
+    return true;
+}
+
+inline bool Tty::setBaudRate(uint32_t baud) {
+    if (fd < 0)
+        return false;
+
+    termios tio{};
+    if (tcgetattr(fd, &tio) != 0) {
+        logger.error() << "tcgetattr failed: " << strerror(errno);
+        return false;
+    }
+    // Bytes still queued would go out at the new rate.
+    ::tcdrain(fd);
+    if (!applySpeed(tio, baud))
+        return false;
+
+    config.baudRate = baud;
+    logger.info() << "TTY switched to " << baud << " baud";
+    return true;
+}
+
+// Sets tio and the rate in a single TCSETS2. Both rate fields of c_cflag
+// are rewritten, so no input rate is left over from an earlier BOTHER one,
+// and the previous settings are put back if the driver rejects the new ones.
+inline bool Tty::applySpeed(const termios &tio, uint32_t baud) {
+    const speed_t speed = standardSpeed(baud);
+#if defined(__powerpc__) || defined(__alpha__) || defined(__sparc__) || defined(__mips__)
+    // Different termios2 layout and BOTHER value; standard rates only.
+    if (0U == speed) {
+        logger.error() << baud << " baud is not a standard rate on this architecture";
+        return false;
+    }
+    termios next = tio;
+    cfsetispeed(&next, speed);
+    cfsetospeed(&next, speed);
+    if (tcsetattr(fd, TCSANOW, &next) != 0) {
+        logger.error() << "tcsetattr (" << baud << " baud) failed: " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    static constexpr tcflag_t Bother = 0010000;
+    static constexpr unsigned InputShift = 16U;
+    static constexpr unsigned long GetTermios2 = _IOR('T', 0x2A, Termios2);
+    static constexpr unsigned long SetTermios2 = _IOW('T', 0x2B, Termios2);
+
+    Termios2 previous{};
+    if (::ioctl(fd, GetTermios2, &previous) != 0) {
+        logger.error() << "TCGETS2 failed: " << strerror(errno);
+        return false;
+    }
+
+    Termios2 next{};
+    next.c_iflag = tio.c_iflag;
+    next.c_oflag = tio.c_oflag;
+    next.c_cflag = tio.c_cflag & ~(CBAUD | (CBAUD << InputShift));
+    next.c_lflag = tio.c_lflag;
+    next.c_line = tio.c_line;
+    std::copy_n(tio.c_cc, sizeof(next.c_cc), next.c_cc);
+    // An input rate of zero follows the output rate.
+    next.c_cflag |= (0U != speed) ? speed : (Bother | (Bother << InputShift));
+    next.c_ispeed = baud;
+    next.c_ospeed = baud;
+
+    if (::ioctl(fd, SetTermios2, &next) != 0) {
+        logger.error() << "TCSETS2 (" << baud << " baud) failed: " << strerror(errno);
+        (void)::ioctl(fd, SetTermios2, &previous);
+        return false;
+    }
+    return true;
+#endif
+}
+
+// Best effort: only drivers of real UARTs know the flag.
+inline void Tty::setLowLatency() {
+    serial_struct serial{};
+    if (::ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        if (::ioctl(fd, TIOCSSERIAL, &serial) == 0)
+            return;
+    }
+    logger.debug() << "low latency mode not supported: " << strerror(errno);
+}
+
+inline speed_t Tty::standardSpeed(uint32_t baud) {
+    static constexpr struct {
+        uint32_t baud;
+        speed_t speed;
+    } speeds[] = {
+        {1200U, B1200},       {2400U, B2400},       {4800U, B4800},       {9600U, B9600},
+        {19200U, B19200},     {38400U, B38400},     {57600U, B57600},     {115200U, B115200},
+        {230400U, B230400},   {460800U, B460800},   {500000U, B500000},   {576000U, B576000},
+        {921600U, B921600},   {1000000U, B1000000}, {1152000U, B1152000}, {1500000U, B1500000},
+        {2000000U, B2000000}, {2500000U, B2500000}, {3000000U, B3000000}, {3500000U, B3500000},
+        {4000000U, B4000000},
+    };
+    for (const auto &entry : speeds) {
+        if (entry.baud == baud)
+            return entry.speed;
+    }
+    return 0U;
+}
+
+inline void Tty::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+inline bool Tty::setNonBlocking(bool enabled) {
+    const int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0)
+        return false;
+    const int wanted = enabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return ::fcntl(fd, F_SETFL, wanted) == 0;
+}
+
+inline size_t Tty::write(gsl::span<const std::string_view> chunks) {
+    if (fd < 0)
+        return 0;
+
+    for (const auto &chunk : chunks) {
+        print("tty-tx", chunk);
+    }
+
+    // The tty is non-blocking: a partial write resumes from the first byte
+    // not taken, after waiting for the transmitter to drain.
+    ChunkCursor cursor{chunks};
+    std::array<iovec, 16U> iov;
+    size_t total = 0U;
+
+    while (true) {
+        const size_t count = cursor.fill(iov);
+        if (0U == count)
+            break;
+
+        ssize_t n = ::writev(fd, iov.data(), static_cast<int>(count));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && waitWritable())
+                continue;
+            logger.error() << "write failed: " << strerror(errno);
+            break;
+        }
+
+        total += static_cast<size_t>(n);
+        cursor.advance(static_cast<size_t>(n));
+    }
+
+    if (tap.enabled()) {
+        tap.record(CaptureTap::Direction::Tx, chunks, total);
+    }
+    ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Trace, "tx complete (%zu bytes)", total);
+    return total;
+}
+
+inline size_t Tty::read(gsl::span<char> buf) {
+    if (fd < 0 || buf.empty())
+        return 0;
+
+    // Use ssize_t to capture -1 correctly.
+    ssize_t r = ::read(fd, buf.data(), buf.size());
+    if (r < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            // No data available right now
+            return 0;
+        }
+        logger.error() << "read failed: " << strerror(errno);
+        return 0;
+    }
+
+    const size_t len = static_cast<size_t>(r);
+    if (tap.enabled() && (0U < len)) {
+        tap.record(CaptureTap::Direction::Rx, {buf.data(), len});
+    }
+
+    // Log rx contents for debugging/trace
+    print("tty-rx", {buf.data(), len});
+
+    ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Trace, "rx read %zu bytes", len);
+    return len;
+}
+
+inline bool Tty::waitWritable() {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+
+    int rc = ::poll(&pfd, 1, writeTimeoutMs);
+    return (rc > 0) && ((pfd.revents & POLLOUT) != 0);
+}
+
+inline void Tty::print(const char *prefix, const std::string_view str) {
+    ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Trace, "%s: len=%zu", prefix, str.size());
+    if (!str.empty()) {
+        // Escaped as <CR>, <LF> and <0xNN> when rendered.
+        ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Debug, "%s: data=%s", prefix, str);
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -0,0 +1,386 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Reads from the current position of a tty need the 5.6 headers.
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+#define ATLINK_HAS_IO_URING 1
+#else
+#define ATLINK_HAS_IO_URING 0
+#endif
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+#if ATLINK_HAS_IO_URING
+
+// One io_uring shared by the ttys of all devices, driven through the raw
+// syscalls. Any thread may queue and submit requests; a single thread
+// reaps the completions of all devices in batches and hands them to the
+// handlers. Requests queued from a handler go out with the next wait, at
+// no extra syscall. The thread runs as long as the ring exists.
+class Uring {
+  public:
+    enum class Op : uint8_t {
+        Read = 1U,
+        Write = 2U,
+        Cancel = 3U,
+    };
+
+    class Handler {
+      public:
+        virtual void onComplete(Op op, int32_t res) = 0;
+        virtual ~Handler() = default;
+    };
+
+    static constexpr unsigned Entries = 512U;
+
+    static Uring &instance() {
+        static Uring uring;
+        return uring;
+    }
+
+    // False if the kernel lacks io_uring, forbids it or is too old.
+    bool available() const {
+        return ringFd >= 0;
+    }
+
+    // The handler must stay alive until the completion of every request
+    // it queued has been delivered.
+    bool queueRead(Handler &handler, int fd, void *buf, uint32_t len);
+    bool queueWritev(Handler &handler, int fd, const iovec *iov, uint32_t count);
+    bool queueCancel(Handler &handler, Op op);
+    void submit();
+
+  private:
+    Uring();
+    ~Uring();
+
+    static uint64_t userData(Handler &handler, Op op) {
+        return reinterpret_cast<uintptr_t>(&handler) | static_cast<uintptr_t>(op);
+    }
+
+    io_uring_sqe *nextSqe();
+    void commitSqe();
+    unsigned takeUnsubmitted();
+    void enter(unsigned toSubmit, unsigned minComplete, unsigned flags);
+    void stop();
+    void loop();
+    void reap();
+
+    Api::Logger<Linux::AsyncLogger> logger;
+    int ringFd{-1};
+    void *ring{MAP_FAILED};
+    size_t ringSize{0U};
+    io_uring_sqe *sqes{nullptr};
+    size_t sqesSize{0U};
+
+    unsigned *sqHead{nullptr};
+    unsigned *sqTail{nullptr};
+    unsigned *sqArray{nullptr};
+    unsigned sqMask{0U};
+    unsigned sqEntries{0U};
+    unsigned *cqHead{nullptr};
+    unsigned *cqTail{nullptr};
+    io_uring_cqe *cqes{nullptr};
+    unsigned cqMask{0U};
+
+    std::mutex mtx;
+    unsigned unsubmitted{0U};
+    std::thread worker;
+    std::atomic<bool> run{false};
+
+    // Disallow copy
+    Uring(const Uring &) = delete;
+    Uring &operator=(const Uring &) = delete;
+};
+
+inline Uring::Uring() : logger{"uring"} {
+    io_uring_params params{};
+    ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, Entries, &params));
+    if (ringFd < 0) {
+        logger.info() << "io_uring_setup failed: " << strerror(errno);
+        return;
+    }
+
+    // Reads from the current position of a tty need 5.6 or later.
+    const unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_RW_CUR_POS;
+    if ((params.features & required) != required) {
+        logger.info() << "io_uring too old";
+        ::close(ringFd);
+        ringFd = -1;
+        return;
+    }
+
+    const size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ringSize = (sqSize < cqSize) ? cqSize : sqSize;
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    ring = ::mmap(nullptr,
+                  ringSize,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  ringFd,
+                  IORING_OFF_SQ_RING);
+    void *entries = ::mmap(nullptr,
+                           sqesSize,
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE,
+                           ringFd,
+                           IORING_OFF_SQES);
+    if ((MAP_FAILED == ring) || (MAP_FAILED == entries)) {
+        logger.error() << "io_uring mmap failed: " << strerror(errno);
+        if (MAP_FAILED != ring)
+            ::munmap(ring, ringSize);
+        if (MAP_FAILED != entries)
+            ::munmap(entries, sqesSize);
+        ring = MAP_FAILED;
+        ::close(ringFd);
+        ringFd = -1;
+        return;
+    }
+
+    auto *base = static_cast<unsigned char *>(ring);
+    sqes = static_cast<io_uring_sqe *>(entries);
+    sqHead = reinterpret_cast<unsigned *>(base + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(base + params.sq_off.tail);
+    sqArray = reinterpret_cast<unsigned *>(base + params.sq_off.array);
+    sqMask = *reinterpret_cast<unsigned *>(base + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    cqHead = reinterpret_cast<unsigned *>(base + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(base + params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe *>(base + params.cq_off.cqes);
+    cqMask = *reinterpret_cast<unsigned *>(base + params.cq_off.ring_mask);
+
+    logger.debug() << "io_uring ready (" << sqEntries << " entries)";
+    run.store(true, std::memory_order_release);
+    worker = std::thread(&Uring::loop, this);
+}
+
+inline Uring::~Uring() {
+    stop();
+    if (nullptr != sqes)
+        ::munmap(sqes, sqesSize);
+    if (MAP_FAILED != ring)
+        ::munmap(ring, ringSize);
+    if (ringFd >= 0)
+        ::close(ringFd);
+}
+
+inline bool Uring::queueRead(Handler &handler, int fd, void *buf, uint32_t len) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto *sqe = nextSqe();
+    if (nullptr == sqe)
+        return false;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->off = ~uint64_t{0U};
+    sqe->addr = reinterpret_cast<uintptr_t>(buf);
+    sqe->len = len;
+    sqe->user_data = userData(handler, Op::Read);
+    commitSqe();
+    return true;
+}
+
+inline bool Uring::queueWritev(Handler &handler, int fd, const iovec *iov, uint32_t count) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto *sqe = nextSqe();
+    if (nullptr == sqe)
+        return false;
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = fd;
+    sqe->off = ~uint64_t{0U};
+    sqe->addr = reinterpret_cast<uintptr_t>(iov);
+    sqe->len = count;
+    sqe->user_data = userData(handler, Op::Write);
+    commitSqe();
+    return true;
+}
+
+inline bool Uring::queueCancel(Handler &handler, Op op) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto *sqe = nextSqe();
+    if (nullptr == sqe)
+        return false;
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData(handler, op);
+    sqe->user_data = userData(handler, Op::Cancel);
+    commitSqe();
+    return true;
+}
+
+inline void Uring::submit() {
+    enter(takeUnsubmitted(), 0U, 0U);
+}
+
+inline io_uring_sqe *Uring::nextSqe() {
+    const unsigned tail = *sqTail;
+    const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (sqEntries <= (tail - head)) {
+        logger.error() << "submission queue full";
+        return nullptr;
+    }
+    const unsigned index = tail & sqMask;
+    sqArray[index] = index;
+    auto *sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+inline void Uring::commitSqe() {
+    __atomic_store_n(sqTail, *sqTail + 1U, __ATOMIC_RELEASE);
+    ++unsubmitted;
+}
+
+inline unsigned Uring::takeUnsubmitted() {
+    std::lock_guard<std::mutex> lk(mtx);
+    const unsigned n = unsubmitted;
+    unsubmitted = 0U;
+    return n;
+}
+
+inline void Uring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    if ((0U == toSubmit) && (0U == minComplete))
+        return;
+
+    const long rc =
+        ::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0U);
+    const unsigned submitted = (rc < 0) ? 0U : static_cast<unsigned>(rc);
+    if ((rc < 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+        logger.error() << "io_uring_enter failed: " << strerror(errno);
+    }
+    // Whatever the kernel did not take stays queued for the next call.
+    if (submitted < toSubmit) {
+        std::lock_guard<std::mutex> lk(mtx);
+        unsubmitted += toSubmit - submitted;
+    }
+}
+
+inline void Uring::stop() {
+    run.store(false, std::memory_order_release);
+    if (!worker.joinable() || (std::this_thread::get_id() == worker.get_id()))
+        return;
+
+    // A no-op completion wakes the thread to see the flag.
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        auto *sqe = nextSqe();
+        if (nullptr != sqe) {
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = 0U;
+            commitSqe();
+        }
+    }
+    submit();
+    worker.join();
+}
+
+inline void Uring::loop() {
+    while (run.load(std::memory_order_acquire)) {
+        enter(takeUnsubmitted(), 1U, IORING_ENTER_GETEVENTS);
+        reap();
+    }
+}
+
+inline void Uring::reap() {
+    unsigned head = *cqHead;
+    const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+        const io_uring_cqe cqe = cqes[head & cqMask];
+        ++head;
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        if (0U == cqe.user_data)
+            continue;
+        const auto op = static_cast<Op>(cqe.user_data & 0x7U);
+        auto *handler = reinterpret_cast<Handler *>(cqe.user_data & ~uint64_t{0x7U});
+        handler->onComplete(op, cqe.res);
+    }
+}
+
+#else
+
+// Kernel headers without a usable io_uring: never available, so the
+// UringDeviceIO always takes its epoll fallback.
+class Uring {
+  public:
+    enum class Op : uint8_t {
+        Read = 1U,
+        Write = 2U,
+        Cancel = 3U,
+    };
+
+    class Handler {
+      public:
+        virtual void onComplete(Op op, int32_t res) = 0;
+        virtual ~Handler() = default;
+    };
+
+    static Uring &instance() {
+        static Uring uring;
+        return uring;
+    }
+
+    bool available() const {
+        return false;
+    }
+
+    bool queueRead(Handler &, int, void *, uint32_t) {
+        return false;
+    }
+    bool queueWritev(Handler &, int, const iovec *, uint32_t) {
+        return false;
+    }
+    bool queueCancel(Handler &, Op) {
+        return false;
+    }
+    void submit() {}
+};
+
+#endif
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
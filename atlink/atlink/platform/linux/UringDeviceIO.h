@@ -0,0 +1,317 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will backend useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "atlink/platform/api/DeviceIO.h"
+
+#include "atlink/platform/api/BinaryLog.h"
+#include "atlink/platform/api/Logger.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/BinaryLog.h"
+#include "atlink/platform/linux/CaptureTap.h"
+#include "atlink/platform/linux/EpollDeviceIO.h"
+#include "atlink/platform/linux/Tty.h"
+#include "atlink/platform/linux/Uring.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <gsl/span>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace ATL_NS {
+namespace Platform {
+namespace Impl {
+namespace Linux {
+
+// DeviceIO backend on the shared io_uring. A read is always posted ahead
+// into one of two receive buffers, so input is already in memory when
+// RxReady is announced and read() is a copy. Writes go out as one writev
+// request per transfer. Falls back to EpollDeviceIO if io_uring cannot
+// be used.
+class UringDeviceIO : private Uring::Handler {
+  public:
+    explicit UringDeviceIO(const Api::SerialConfig &config = {});
+    ~UringDeviceIO();
+    using Subscriber = ATL_NS::Platform::Api::Subscriber;
+    void subscribe(Subscriber &l);
+
+    size_t write(std::string_view s);
+    size_t write(gsl::span<const std::string_view> chunks);
+    size_t read(gsl::span<char> buf);
+    bool setBaudRate(uint32_t baud);
+
+  private:
+    static constexpr size_t RxBufferSize = 256U;
+
+    struct RxBuffer {
+        std::array<char, RxBufferSize> data{};
+        size_t length{0U};
+        size_t offset{0U};
+    };
+
+    Api::Logger<Linux::AsyncLogger> logger;
+    Tty tty;
+    CaptureTap &tap{CaptureTap::instance()};
+    Uring *uring{nullptr};
+    std::optional<EpollDeviceIO> fallback;
+    std::atomic<Subscriber *> subscriber{nullptr};
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    // Buffers are filled and drained in turn, starting at rx[head].
+    std::array<RxBuffer, 2U> rx;
+    size_t head{0U};
+    size_t filled{0U};
+    bool reading{false};
+    bool writing{false};
+    bool closing{false};
+    int32_t writeResult{0};
+    size_t pending{0U};
+
+    void onComplete(Uring::Op op, int32_t res) override;
+    bool postRead();
+    void notifyRx();
+
+    // Disallow copy
+    UringDeviceIO(const UringDeviceIO &) = delete;
+    UringDeviceIO &operator=(const UringDeviceIO &) = delete;
+};
+
+inline UringDeviceIO::UringDeviceIO(const Api::SerialConfig &config)
+    : logger{"deviceio"}, tty{logger, config} {
+    auto &shared = Uring::instance();
+    if (!shared.available()) {
+        logger.warn() << "io_uring unavailable, falling back to epoll";
+        fallback.emplace(config);
+        return;
+    }
+
+    if (!tty.open() || !tty.setNonBlocking(false)) {
+        logger.error() << "DeviceIO initialization failed";
+        return;
+    }
+
+    uring = &shared;
+    bool posted = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        posted = postRead();
+    }
+    if (posted) {
+        uring->submit();
+    }
+}
+
+inline UringDeviceIO::~UringDeviceIO() {
+    if (nullptr != uring) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            closing = true;
+            if (reading) {
+                while (!uring->queueCancel(*this, Uring::Op::Read)) {
+                    uring->submit();
+                }
+                ++pending;
+            }
+        }
+        uring->submit();
+
+        // Completions refer to this object and its buffers.
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait(lk, [this] { return 0U == pending; });
+        lk.unlock();
+    }
+    tty.close();
+    logger.info() << "device closed";
+}
+
+inline void UringDeviceIO::subscribe(Subscriber &s) {
+    if (fallback) {
+        fallback->subscribe(s);
+        return;
+    }
+    subscriber.store(&s, std::memory_order_release);
+    logger.debug() << "subscriber registered";
+    notifyRx();
+}
+
+inline size_t UringDeviceIO::write(std::string_view s) {
+    return write(gsl::span<const std::string_view>{&s, 1U});
+}
+
+inline size_t UringDeviceIO::write(gsl::span<const std::string_view> chunks) {
+    if (fallback)
+        return fallback->write(chunks);
+    if (nullptr == uring)
+        return 0;
+
+    ChunkCursor cursor{chunks};
+    std::array<iovec, 16U> iov;
+    size_t total = 0U;
+
+    while (true) {
+        const size_t count = cursor.fill(iov);
+        if (0U == count)
+            break;
+
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (!uring->queueWritev(*this, tty.handle(), iov.data(), count))
+                break;
+            writing = true;
+            ++pending;
+        }
+        uring->submit();
+
+        int32_t res = 0;
+        {
+            std::unique_lock<std::mutex> lk(mtx);
+            cv.wait(lk, [this] { return !writing; });
+            res = writeResult;
+        }
+        if (res < 0) {
+            if ((res == -EINTR) || (res == -EAGAIN))
+                continue;
+            logger.error() << "write failed: " << strerror(-res);
+            break;
+        }
+
+        total += static_cast<size_t>(res);
+        cursor.advance(static_cast<size_t>(res));
+    }
+
+    if (tap.enabled()) {
+        tap.record(CaptureTap::Direction::Tx, chunks, total);
+    }
+    ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Trace, "tx complete (%zu bytes)", total);
+    return total;
+}
+
+inline size_t UringDeviceIO::read(gsl::span<char> buf) {
+    if (fallback)
+        return fallback->read(buf);
+    if (nullptr == uring)
+        return 0;
+
+    size_t n = 0U;
+    bool more = false;
+    bool posted = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        while ((n < buf.size()) && (0U < filled)) {
+            auto &b = rx[head];
+            const size_t take = std::min(buf.size() - n, b.length - b.offset);
+            std::memcpy(buf.data() + n, b.data.data() + b.offset, take);
+            b.offset += take;
+            n += take;
+            if (b.offset == b.length) {
+                --filled;
+                head ^= 1U;
+            }
+        }
+        more = (0U < filled);
+        // Normally the completion has posted the next read already; it
+        // could not while both buffers were full.
+        posted = postRead();
+    }
+    if (posted) {
+        uring->submit();
+    }
+    if (more) {
+        notifyRx();
+    }
+
+    if (tap.enabled() && (0U < n)) {
+        tap.record(CaptureTap::Direction::Rx, {buf.data(), n});
+    }
+    ATL_BLOG_TO(Api::BinaryLog<BinaryLog>, logger, Trace, "rx read %zu bytes", n);
+    return n;
+}
+
+inline bool UringDeviceIO::setBaudRate(uint32_t baud) {
+    if (fallback)
+        return fallback->setBaudRate(baud);
+    return tty.setBaudRate(baud);
+}
+
+inline void UringDeviceIO::onComplete(Uring::Op op, int32_t res) {
+    bool received = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        --pending;
+        switch (op) {
+        case Uring::Op::Read:
+            reading = false;
+            if (0 < res) {
+                auto &b = rx[(head + filled) % rx.size()];
+                b.length = static_cast<size_t>(res);
+                b.offset = 0U;
+                ++filled;
+                received = true;
+            } else if ((res != -EINTR) && (res != -EAGAIN)) {
+                if (!closing) {
+                    logger.error() << "read failed: " << ((0 == res) ? "hangup" : strerror(-res));
+                }
+                break;
+            }
+            // Queued only; the reaping thread submits it with its next wait.
+            (void)postRead();
+            break;
+        case Uring::Op::Write:
+            writeResult = res;
+            writing = false;
+            break;
+        case Uring::Op::Cancel:
+            break;
+        }
+    }
+    cv.notify_all();
+    if (received) {
+        notifyRx();
+    }
+}
+
+inline bool UringDeviceIO::postRead() {
+    if (reading || closing || (rx.size() <= filled))
+        return false;
+
+    auto &b = rx[(head + filled) % rx.size()];
+    if (!uring->queueRead(*this, tty.handle(), b.data.data(), RxBufferSize))
+        return false;
+    reading = true;
+    ++pending;
+    return true;
+}
+
+inline void UringDeviceIO::notifyRx() {
+    if (auto *sub = subscriber.load(std::memory_order_acquire)) {
+        sub->notify(Subscriber::Event::RxReady);
+    }
+}
+
+} // namespace Linux
+} // namespace Impl
+} // namespace Platform
+} // namespace ATL_NS
@@ -38,7 +38,7 @@ class Response : public Core::MultiLineResponse {
   public:
     class Manufacturer : Core::Line {
       public:
-        std::array<char, 32U> storage{};
+        std::array<char, 32U> storage;
         Core::LineText name{storage};
 
         Manufacturer() : Core::Line() {}
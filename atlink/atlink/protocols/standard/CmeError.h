@@ -33,7 +33,9 @@ class CmeError : public Core::Response {
 
     Core::Enum<Code> code{};
 
-    CmeError() : Core::Response("+CME ERROR:") {}
+    static constexpr Core::ReadOnlyText Tag{"+CME ERROR:"};
+
+    CmeError() : Core::Response(Tag) {}
     ~CmeError() = default;
     bool accept(Core::AResponseVisitor &visitor) override {
         return APacket::accept(visitor, code);
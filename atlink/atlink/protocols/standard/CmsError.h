@@ -32,7 +32,9 @@ class CmsError : public Core::Response {
 
     Core::Enum<Code> code{};
 
-    CmsError() : Core::Response("+CMS ERROR:") {}
+    static constexpr Core::ReadOnlyText Tag{"+CMS ERROR:"};
+
+    CmsError() : Core::Response(Tag) {}
     ~CmsError() = default;
     bool accept(Core::AResponseVisitor &visitor) override {
         return APacket::accept(visitor, code);
@@ -41,4 +43,11 @@ class CmsError : public Core::Response {
 
 } // namespace Std
 } // namespace Proto
-} // namespace ATL_NS
\ No newline at end of file
+} // namespace ATL_NS
+
+// CMS error codes go up to 511 (3GPP TS 27.005), beyond magic_enum's default range.
+template <>
+struct magic_enum::customize::enum_range<ATL_NS::Proto::Std::CmsError::Code> {
+    static constexpr int min = 0;
+    static constexpr int max = 511;
+};
\ No newline at end of file
@@ -57,7 +57,9 @@ class CpinReadResponse : public Core::Response {
 
     Core::Enum<Code> code;
 
-    CpinReadResponse() : Core::Response("+CPIN: ") {}
+    static constexpr Core::ReadOnlyText Tag{"+CPIN: "};
+
+    CpinReadResponse() : Core::Response(Tag) {}
     ~CpinReadResponse() = default;
     bool accept(Core::AResponseVisitor &visitor) override {
         return APacket::accept(visitor, code);
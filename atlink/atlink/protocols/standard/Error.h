@@ -25,11 +25,14 @@ namespace Std {
 
 class Error : public Core::Response {
   public:
+    // Not selected by a tag, the numeric form "4" has none.
+    static constexpr Core::ReadOnlyText Tag{};
+
     Error() : Core::Response("ERROR") {}
     ~Error() = default;
 
     bool accept(Core::AResponseVisitor &visitor) override {
-        return APacket::accept(visitor);
+        return visitor.visit(Core::ResultCode{tag.view(), 4U});
     }
 };
 
@@ -0,0 +1,36 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Format.h"
+
+namespace ATL_NS {
+namespace Proto {
+namespace Std {
+namespace Ipr {
+namespace Write {
+
+// Sets the fixed baud rate of the modem's UART. The OK still comes at the
+// old rate; the modem switches right after it.
+ATL_COMMAND(Command, "AT+IPR=%u", rate);
+
+} // namespace Write
+} // namespace Ipr
+} // namespace Std
+} // namespace Proto
+} // namespace ATL_NS
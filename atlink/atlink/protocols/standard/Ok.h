@@ -25,11 +25,14 @@ namespace Std {
 
 class Ok : public Core::Response {
   public:
+    // Not selected by a tag, the numeric form "0" has none.
+    static constexpr Core::ReadOnlyText Tag{};
+
     Ok() : Core::Response("OK") {}
     ~Ok() = default;
 
     bool accept(Core::AResponseVisitor &visitor) override {
-        return Response::acceptImpl(visitor);
+        return visitor.visit(Core::ResultCode{tag.view(), 0U});
     }
 };
 
@@ -0,0 +1,36 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Format.h"
+
+namespace ATL_NS {
+namespace Proto {
+namespace Std {
+namespace Wire {
+namespace Write {
+
+// Sets the line termination (S3), response formatting (S4) characters and
+// verbose (1) or numeric (0) result codes in one command line.
+ATL_COMMAND(Command, "ATS3=%dS4=%dV%d", s3, s4, verbose);
+
+} // namespace Write
+} // namespace Wire
+} // namespace Std
+} // namespace Proto
+} // namespace ATL_NS
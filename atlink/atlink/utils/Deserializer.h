@@ -20,89 +20,336 @@
 #include "atlink/core/Constants.h"
 #include "atlink/core/Packet.h"
 
+#include <array>
 #include <charconv>
+#include <cstdint>
+#include <limits>
 
 namespace ATL_NS {
 namespace Utils {
 
+// Outcome of the visits of an earlier attempt to parse the same input.
+// A visit whose result cannot change when more bytes are appended is
+// recorded, and the next attempt replays it instead of parsing it again.
+// Replayed visits do not write to their target, so a progress must only be
+// shared between attempts on the same packet instance, and reset whenever
+// the start of the input moves. Packs that try several alternatives rewind
+// the visitor, which drops the progress, and are parsed in full each time.
+// Lists with a sink drop it as well, and are parsed again on every attempt.
+class ParseProgress {
+  public:
+    static constexpr size_t Capacity = 32U;
+
+    void reset() {
+        count = 0U;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+  private:
+    friend class Deserializer;
+
+    struct Step {
+        size_t end;
+        bool ok;
+    };
+
+    std::array<Step, Capacity> steps{};
+    size_t count{0U};
+};
+
 class Deserializer : public Core::AResponseVisitor {
 
     Core::ReadOnlyText input;
     size_t length = 0;
+    Core::WireProfile wire{};
+
+    ParseProgress *progress{nullptr};
+    size_t index{0U};
+    bool settled{true};
+    bool exhaustedInput{false};
 
   public:
-    explicit Deserializer(Core::ReadOnlyText input) : input(input) {}
+    explicit Deserializer(Core::ReadOnlyText input, Core::WireProfile wire = {})
+        : input(input), wire(wire) {}
+    Deserializer(Core::ReadOnlyText input, ParseProgress &progress, Core::WireProfile wire = {})
+        : input(input), wire(wire), progress(&progress) {}
     ~Deserializer() = default;
 
     void rewind() override {
         length = 0U;
+        index = 0U;
+        settled = true;
+        // Steps of one alternative must not be replayed for the next.
+        discardProgress();
+    }
+
+    void discardProgress() override {
+        if (nullptr != progress) {
+            progress->reset();
+            progress = nullptr;
+        }
+    }
+
+    // Unlike consumed(), it is not cleared by rewind().
+    bool exhausted() const override {
+        return exhaustedInput;
     }
 
     bool visit(const Core::Sequence &seq) override {
-        skipWhitespaces();
-        auto n = seq.parse(input.substr(length));
-        length += n;
-        return (0U < n);
-        ;
+        return step([&]() {
+            skipWhitespaces();
+            if (Core::Constants::Literals::CrLf == seq.view()) {
+                return parseFraming();
+            }
+            auto n = seq.parse(input.substr(length));
+            length += n;
+            return (0U < n);
+        });
     }
 
     bool visit(Core::QuotedStringStorage str) override {
-        skipWhitespaces();
-        std::string_view in = input.substr(length);
-        auto consumed = parseStringLiteral(in, str);
-        length += consumed;
-        return (0U < consumed);
+        return step([&]() {
+            skipWhitespaces();
+            std::string_view in = input.substr(length);
+            auto consumed = parseStringLiteral(in, str);
+            length += consumed;
+            return (0U < consumed);
+        });
     }
 
     bool visit(Core::LineText &line) override {
-        std::array<char, 3U> term{};
-        auto success = Core::Constants::CrLf.stringify(term);
-        assert(success);
+        return step([&]() { return parseLine(line); });
+    }
 
-        std::string_view in = input.substr(length);
-        auto pos = in.find(term.data());
+    bool visit(Core::AEnum &e) override {
+        return step([&]() {
+            skipWhitespaces();
+            auto n = e.parse(input.substr(length));
+            length += n;
+            return (0U < n);
+        });
+    }
 
-        std::size_t take = 0U;
-        if (pos == std::string_view::npos) {
-            take = std::min<std::size_t>(in.size(), line.buf.size());
-        } else {
-            take = std::min<std::size_t>(pos, line.buf.size());
+    bool visit(int &i) override {
+        return step([&]() { return parseNumber(i); });
+    }
+
+    bool visit(int64_t &i) override {
+        return step([&]() { return parseNumber(i); });
+    }
+
+    bool visit(uint32_t &u) override {
+        return step([&]() { return parseNumber(u); });
+    }
+
+    bool visit(Core::Hex &h) override {
+        return step([&]() {
+            skipWhitespaces();
+            const bool quoted = (length < input.size()) && ('"' == input[length]);
+            uint32_t num = 0U;
+            auto end = fromChars(length + (quoted ? 1U : 0U), num, 16);
+            if (quoted && (0U < end)) {
+                end = ((end < input.size()) && ('"' == input[end])) ? (end + 1U) : 0U;
+            }
+            if (0U < end) {
+                h.value = num;
+                h.quoted = quoted;
+                length = end;
+            }
+            return (0U < end);
+        });
+    }
+
+    bool visit(Core::FixedPoint &f) override {
+        return step([&]() { return parseFixedPoint(f); });
+    }
+
+    bool visit(double &d) override {
+        return step([&]() { return parseNumber(d); });
+    }
+
+    bool visit(const Core::ResultCode &code) override {
+        return step([&]() { return parseResultCode(code); });
+    }
+
+    Core::ReadOnlyText lookahead() const override {
+        const char blank[] = {wire.s3, wire.s4, ' ', '\t', '\0'};
+        const auto start = input.find_first_not_of(blank, length);
+        return input.substr(std::min(start, input.size()));
+    }
+
+    size_t consumed() const override {
+        return length;
+    }
+
+  private:
+    // Runs one visit, or replays it from the progress of an earlier attempt.
+    // A successful visit is final once it stopped before the end of the
+    // input; a failed one once the rest of its line has been received.
+    template <typename Parse>
+    bool step(Parse &&parse) {
+        if ((nullptr != progress) && (index < progress->count)) {
+            const auto &replayed = progress->steps[index++];
+            length = replayed.end;
+            return replayed.ok;
         }
 
-        for (std::size_t i = 0; i < take; ++i) {
-            line.buf[i] = in[i];
+        const auto start = length;
+        const bool ok = parse();
+        // Without verbose result codes S3 may still be followed by S4.
+        const auto end = input.find(wire.lineEnd(), start);
+        const bool lineComplete =
+            (std::string_view::npos != end) && (wire.verbose || ((end + 1U) < input.size()));
+        const bool final = ok ? (length < input.size()) : lineComplete;
+
+        if (!ok && !lineComplete) {
+            exhaustedInput = true;
         }
 
-        length += take;
-        return (0U < take);
+        if ((nullptr != progress) && settled && final && (index < ParseProgress::Capacity)) {
+            progress->steps[index++] = ParseProgress::Step{length, ok};
+            progress->count = index;
+        } else {
+            settled = false;
+        }
+        return ok;
     }
 
-    bool visit(Core::AEnum &e) override {
+    // Returns the offset just past the parsed number, or 0 if there is none.
+    template <typename T, typename... Base>
+    size_t fromChars(size_t pos, T &value, Base... base) const {
+        const auto *first = input.data() + std::min(pos, input.size());
+        const auto *last = input.data() + input.size();
+        auto result = std::from_chars(first, last, value, base...);
+        return (std::errc{} == result.ec) ? static_cast<size_t>(result.ptr - input.data()) : 0U;
+    }
+
+    template <typename T>
+    bool parseNumber(T &out) {
         skipWhitespaces();
-        auto n = e.parse(input.substr(length));
-        length += n;
-        return (0U < n);
+        T num{};
+        auto end = fromChars(length, num);
+        if (0U < end) {
+            out = num;
+            length = end;
+        }
+        return (0U < end);
     }
 
-    bool visit(int &i) override {
+    // Fails rather than wraps if the scaled value does not fit into raw.
+    bool parseFixedPoint(Core::FixedPoint &out) {
+        static constexpr auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        const auto scaleUp = [](uint64_t &value, unsigned digit) {
+            if (((limit - digit) / 10U) < value) {
+                return false;
+            }
+            value = (value * 10U) + digit;
+            return true;
+        };
+
         skipWhitespaces();
-        const auto *first = input.data() + length;
-        const auto *last = input.data() + input.size();
-        int num = 0U;
-        auto result = std::from_chars(first, last, num);
-        auto success = (result.ec == std::errc{});
-        if (success) {
-            i = num;
-            length += result.ptr - (input.data() + length);
+        auto pos = length;
+        const bool negative = (pos < input.size()) && ('-' == input[pos]);
+        uint64_t raw = 0U;
+        pos = fromChars(pos + (negative ? 1U : 0U), raw);
+        if ((0U == pos) || (limit < raw)) {
+            return false;
         }
-        return success;
+
+        uint8_t digits = 0U;
+        if ((pos < input.size()) && ('.' == input[pos])) {
+            ++pos;
+            while ((pos < input.size()) && ('0' <= input[pos]) && (input[pos] <= '9')) {
+                if (digits < out.decimals) {
+                    if (!scaleUp(raw, static_cast<unsigned>(input[pos] - '0'))) {
+                        return false;
+                    }
+                    ++digits;
+                }
+                ++pos;
+            }
+        }
+        for (; digits < out.decimals; ++digits) {
+            if (!scaleUp(raw, 0U)) {
+                return false;
+            }
+        }
+
+        const auto value = static_cast<int64_t>(raw);
+        out.raw = negative ? -value : value;
+        length = pos;
+        return true;
     }
 
-    size_t consumed() const override {
-        return length;
+    // Matches the end of a line, CrLf in the packet definitions. It stands
+    // for S3 S4, where S4 may be missing without verbose result codes.
+    bool parseFraming() {
+        auto pos = length;
+        if ((pos < input.size()) && (wire.s3 == input[pos])) {
+            ++pos;
+            if ((pos < input.size()) && (wire.s4 == input[pos])) {
+                length = pos + 1U;
+                return true;
+            }
+            if (!wire.verbose) {
+                length = pos;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Without verbose result codes the number is tried first, it is told
+    // apart by its first byte. The text is accepted in either mode so that
+    // the answer to the command switching the mode is understood.
+    bool parseResultCode(const Core::ResultCode &code) {
+        const char blank[] = {wire.s3, wire.s4, ' ', '\t', '\0'};
+        const auto start = std::min(input.find_first_not_of(blank, length), input.size());
+
+        if (!wire.verbose && (start < input.size()) && ('0' <= input[start]) &&
+            (input[start] <= '9')) {
+            uint32_t number = 0U;
+            const auto end = fromChars(start, number);
+            if ((code.number == number) && (end < input.size()) && (wire.s3 == input[end])) {
+                length = end + 1U;
+                return true;
+            }
+            return false;
+        }
+
+        if (input.substr(start, code.text.size()) != code.text) {
+            return false;
+        }
+        length = start + code.text.size();
+        skipWhitespaces();
+        return parseFraming();
+    }
+
+    bool parseLine(Core::LineText &line) {
+        const char term[] = {wire.s3, wire.verbose ? wire.s4 : '\0', '\0'};
+
+        std::string_view in = input.substr(length);
+        auto pos = in.find(term);
+
+        std::size_t take = 0U;
+        if (pos == std::string_view::npos) {
+            take = std::min<std::size_t>(in.size(), line.buf.size());
+        } else {
+            take = std::min<std::size_t>(pos, line.buf.size());
+        }
+
+        std::copy_n(in.data(), take, line.buf.data());
+        if (take < line.buf.size()) {
+            line.buf[take] = '\0';
+        }
+
+        length += take;
+        return (0U < take);
     }
 
-  private:
     void skipWhitespaces() {
         auto trimmed_input = input.substr(length);
         auto start = trimmed_input.find_first_not_of(" \t");
@@ -114,19 +361,22 @@ class Deserializer : public Core::AResponseVisitor {
         }
     }
 
+    // Returns the number of characters consumed including both quotes, or 0
+    // if the input does not start with a complete string literal. A string
+    // that does not fit into out is not copied, and only its two quotes are
+    // counted as consumed.
     static size_t parseStringLiteral(std::string_view in, gsl::span<char> out) {
         static constexpr auto npos = std::string_view::npos;
-        auto start = in.find("\"");
-        auto end = (npos != start) ? in.find("\"", start + 1U) : npos;
-        size_t length = 0U;
-        if ((npos != start) && (npos != end) && ((start + 1) < end)) {
-            length = end - start - 1;
-            if (length < out.size()) {
-                std::copy_n(in.data() + start + 1, length, out.begin());
-                out[length] = '\0';
-            } else {
-                length = 0U;
-            }
+        auto end = ((0U < in.size()) && ('"' == in[0])) ? in.find('"', 1U) : npos;
+        if (npos == end) {
+            return 0U;
+        }
+        size_t length = end - 1U;
+        if (length < out.size()) {
+            std::copy_n(in.data() + 1, length, out.begin());
+            out[length] = '\0';
+        } else {
+            length = 0U;
         }
         return length + 2;
     }
@@ -21,6 +21,7 @@
 #include <array>
 #include <cassert>
 #include <charconv>
+#include <cstdint>
 #include <magic_enum/magic_enum.hpp>
 #include <optional>
 
@@ -29,6 +30,22 @@
 namespace ATL_NS {
 namespace Utils {
 
+template <size_t Span, typename Values>
+constexpr std::array<uint64_t, (Span + 63U) / 64U> makeEnumBitmap(const Values &values,
+                                                                  int lowest) {
+    std::array<uint64_t, (Span + 63U) / 64U> bits{};
+    for (auto v : values) {
+        const auto offset = static_cast<size_t>(static_cast<int>(v) - lowest);
+        bits[offset / 64U] |= (uint64_t{1U} << (offset % 64U));
+    }
+    return bits;
+}
+
+// Converts enums to and from their numeric value. The declared values are
+// reflected by magic_enum once, at compile time, into a dense bitmap that
+// spans from the lowest to the highest value, so validating a parsed number
+// is a single bit test. Enums with values outside of magic_enum's default
+// range [-128, 127] must specialize magic_enum::customize::enum_range.
 template <typename T, size_t N = 0U>
 class EnumStringConverter {
   public:
@@ -62,17 +79,43 @@ class EnumStringConverter {
         auto result = std::from_chars(first, last, num);
 
         size_t n = 0U;
-        if (result.ec == std::errc{}) {
-            auto opt_enum = magic_enum::enum_cast<T>(num);
-            if (opt_enum.has_value()) {
-                value = opt_enum.value();
-                n = result.ptr - input.data();
-            }
+        if ((result.ec == std::errc{}) && isValid(num)) {
+            value = static_cast<T>(num);
+            n = result.ptr - input.data();
         }
         return n;
     }
+
+    static constexpr bool isValid(int num) {
+        const auto offset = static_cast<int64_t>(num) - lowest;
+        return (0 <= offset) && (offset < static_cast<int64_t>(Span)) &&
+               (0U != (bitmap[offset / 64] & (uint64_t{1U} << (offset % 64))));
+    }
+
+  private:
+    static constexpr auto values = magic_enum::enum_values<T>();
+    static_assert(0U < values.size(),
+                  "No value of T lies in its magic_enum range, "
+                  "specialize magic_enum::customize::enum_range");
+
+    static constexpr int lowest = static_cast<int>(*std::min_element(values.begin(), values.end()));
+    static constexpr int highest =
+        static_cast<int>(*std::max_element(values.begin(), values.end()));
+    static constexpr size_t Span = static_cast<size_t>(highest - lowest) + 1U;
+
+    static constexpr auto bitmap = makeEnumBitmap<Span>(values, lowest);
 };
 
+// Converts enums to and from the strings of an association map that is
+// strictly sorted by string. Both directions are prepared when the
+// converter is constructed, which happens at compile time for the
+// converters of EnumTraits:
+//  - stringify indexes a table by the enum value when the values are
+//    0..N-1 (the common case of an enum without explicit values) and
+//    binary searches a value ordered index otherwise;
+//  - parse walks the sorted map as an implicit trie, narrowing the range
+//    of keys that share the prefix read so far, and returns the longest
+//    key that matches, e.g. "SIM_PIN2" rather than "SIM_PIN".
 template <typename T, size_t N>
 class EnumCustomStringConverter {
   public:
@@ -81,7 +124,27 @@ class EnumCustomStringConverter {
     using Record = std::pair<ATL_NS::Core::ReadOnlyText, T>;
     using Map = std::array<Record, N>;
 
-    constexpr explicit EnumCustomStringConverter(const Map &map) : map{map} {}
+    constexpr explicit EnumCustomStringConverter(const Map &map) : map{map} {
+        for (size_t i = 0U; i < N; ++i) {
+            const auto index = static_cast<size_t>(map[i].second);
+            if ((index < N) && names[index].empty()) {
+                names[index] = map[i].first;
+            } else {
+                dense = false;
+            }
+        }
+
+        // Insertion sort, std::sort is not constexpr in C++17.
+        for (size_t i = 0U; i < N; ++i) {
+            byValue[i] = i;
+            for (size_t j = i; (0U < j) && (map[byValue[j]].second < map[byValue[j - 1U]].second);
+                 --j) {
+                const auto tmp = byValue[j];
+                byValue[j] = byValue[j - 1U];
+                byValue[j - 1U] = tmp;
+            }
+        }
+    }
 
     constexpr size_t stringify(T value, MutableBuffer output) const {
         size_t n = 0;
@@ -94,49 +157,63 @@ class EnumCustomStringConverter {
     }
 
     constexpr size_t parse(T &value, ReadOnlyText input) const {
+        size_t lo = 0U;
+        size_t hi = N;
+        size_t match = N;
         size_t n = 0U;
-        auto result = lookup(input);
-        if (result) {
-            value = result.value();
-            n = lookup(value).size();
+
+        for (size_t depth = 0U; lo < hi; ++depth) {
+            // Keys are sorted, so a key that ends here comes first.
+            if (map[lo].first.size() == depth) {
+                match = lo;
+                n = depth;
+                ++lo;
+            }
+            if (input.size() <= depth) {
+                break;
+            }
+            const char c = input[depth];
+            while ((lo < hi) && (map[lo].first[depth] < c)) {
+                ++lo;
+            }
+            while ((lo < hi) && (c < map[hi - 1U].first[depth])) {
+                --hi;
+            }
+        }
+
+        if ((N != match) && (0U < n)) {
+            value = map[match].second;
+        } else {
+            n = 0U;
         }
         return n;
     }
 
   private:
     const Map &map;
+    std::array<ReadOnlyText, N> names{};
+    std::array<size_t, N> byValue{};
+    bool dense{true};
 
-    // Lookup for the given variant in the association map.
-    // The complexity is O(n) but is it acceptable, because
-    // enum to string conversion is much less frequent than
-    // the opposite direction. Can be improved later.
     constexpr ReadOnlyText lookup(T variant) const {
-        auto matcher = [variant](const Record &i) {
-            return i.second == variant;
-        };
-        auto it = std::find_if(map.begin(), map.end(), matcher);
-        assert(it != map.end());
-        return it->first;
-    }
-
-    // Lookup for the given string in the association map.
-    // The complexity of this search is O(log n)
-    constexpr std::optional<T> lookup(ReadOnlyText str) const {
-        if (str.empty())
-            return std::nullopt;
-
-        auto comp = [](const Record &item, std::string_view value) {
-            return (item.first < (value.substr(0, item.first.size())));
-        };
-
-        auto it = std::lower_bound(map.begin(), map.end(), str, comp);
-
-        if ((it != map.end()) && (it->first.size() <= str.size()) &&
-            (str.substr(0, it->first.size()) == it->first)) {
-            return it->second;
+        if (dense) {
+            const auto index = static_cast<size_t>(variant);
+            assert(index < N);
+            return names[index];
         }
 
-        return std::nullopt;
+        size_t lo = 0U;
+        size_t hi = N;
+        while (lo < hi) {
+            const auto mid = lo + ((hi - lo) / 2U);
+            if (map[byValue[mid]].second < variant) {
+                lo = mid + 1U;
+            } else {
+                hi = mid;
+            }
+        }
+        assert((lo < N) && (map[byValue[lo]].second == variant));
+        return map[byValue[lo]].first;
     }
 };
 
@@ -0,0 +1,135 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "atlink/core/Constants.h"
+#include "atlink/core/Packet.h"
+#include "atlink/utils/Serializer.h"
+
+#include <array>
+#include <gsl/span>
+
+namespace ATL_NS {
+namespace Utils {
+
+// Serializes a command into a list of chunks for a vectored write instead
+// of one contiguous buffer. Tags, literals and strings are referenced where
+// they are, only formatted values are written, back to back, into a small
+// scratch area. Adjacent chunks are merged, so a command usually ends up as
+// a handful of them. The chunks refer to the command, which must outlive
+// the write.
+class GatherSerializer : public Core::ACommandVisitor {
+  public:
+    static constexpr std::size_t MaxChunks = 32U;
+    static constexpr std::size_t ScratchSize = 256U;
+
+    explicit GatherSerializer(Core::WireProfile wire = {}) : wire{wire} {}
+    GatherSerializer(const GatherSerializer &) = delete;
+    GatherSerializer &operator=(const GatherSerializer &) = delete;
+
+    bool visit(const Core::Sequence &s) override {
+        if (Core::Constants::Literals::Cr == s.view()) {
+            return append(Core::ReadOnlyText{&wire.s3, 1U});
+        }
+        return (0U < s.length()) && append(s.view());
+    }
+
+    bool visit(const Core::QuotedStringView s) override {
+        if (Core::ReadOnlyText::npos != s.find('"')) {
+            return format(s);
+        }
+        return append(Core::Constants::Literals::Quote) && (s.empty() || append(s)) &&
+               append(Core::Constants::Literals::Quote);
+    }
+
+    bool visit(const Core::AEnum &e) override {
+        return format(e);
+    }
+
+    bool visit(int i) override {
+        return format(i);
+    }
+
+    bool visit(int64_t i) override {
+        return format(i);
+    }
+
+    bool visit(uint32_t u) override {
+        return format(u);
+    }
+
+    bool visit(const Core::Hex &h) override {
+        return format(h);
+    }
+
+    bool visit(const Core::FixedPoint &f) override {
+        return format(f);
+    }
+
+    bool visit(double d) override {
+        return format(d);
+    }
+
+    std::size_t written() const override {
+        return total;
+    }
+
+    // Adds bytes that are not part of the command line, e.g. its payload.
+    bool append(Core::ReadOnlyText txt) {
+        if (txt.empty()) {
+            return true;
+        }
+        if ((0U < count) && (chunks[count - 1U].data() + chunks[count - 1U].size() == txt.data())) {
+            auto &last = chunks[count - 1U];
+            last = Core::ReadOnlyText{last.data(), last.size() + txt.size()};
+        } else if (count < MaxChunks) {
+            chunks[count++] = txt;
+        } else {
+            return false;
+        }
+        total += txt.size();
+        return true;
+    }
+
+    gsl::span<const Core::ReadOnlyText> output() const {
+        return {chunks.data(), count};
+    }
+
+  private:
+    // Formats a value with the plain Serializer, right behind the previous
+    // one in the scratch area.
+    template <typename T>
+    bool format(const T &value) {
+        const auto before = scratch.written();
+        if (!scratch.visit(value)) {
+            return false;
+        }
+        const auto after = scratch.output();
+        return append(after.substr(before));
+    }
+
+    const Core::WireProfile wire;
+    std::array<char, ScratchSize> storage;
+    Serializer scratch{storage};
+    std::array<Core::ReadOnlyText, MaxChunks> chunks{};
+    std::size_t count{0U};
+    std::size_t total{0U};
+};
+
+} // namespace Utils
+} // namespace ATL_NS
@@ -17,10 +17,11 @@
 
 #pragma once
 
+#include "atlink/core/Constants.h"
 #include "atlink/core/Packet.h"
 
+#include <array>
 #include <charconv>
-#include <cstring>
 
 namespace ATL_NS {
 namespace Utils {
@@ -28,40 +29,99 @@ namespace Utils {
 class Serializer : public Core::ACommandVisitor {
     const Core::MutableBuffer buf;
     Core::MutableBuffer rest;
+    const Core::WireProfile wire;
 
   public:
-    explicit Serializer(Core::MutableBuffer output) : buf(output), rest{output} {
-        memset(rest.data(), 0U, rest.size());
+    // The output is kept NUL-terminated after every visit instead of being
+    // cleared up front, so only the bytes actually written are touched.
+    explicit Serializer(Core::MutableBuffer output, Core::WireProfile wire = {})
+        : buf(output), rest{output}, wire{wire} {
+        terminate();
     }
 
+    // The command terminator is written as the profile's S3.
     bool visit(const Core::Sequence &s) override {
-        auto n = s.stringify(rest);
-        rest = rest.subspan(n);
-        return (0U < n);
+        if (Core::Constants::Literals::Cr == s.view()) {
+            return put(Core::ReadOnlyText{&wire.s3, 1U});
+        }
+        return advance(s.stringify(rest));
     }
 
     bool visit(const Core::QuotedStringView s) override {
-        auto n = writeQuoted(rest, s);
-        rest = rest.subspan(n);
-        return (0U < n);
+        return advance(writeQuoted(rest, s));
     }
 
     bool visit(const Core::AEnum &e) override {
-        auto n = e.stringify(rest);
-        rest = rest.subspan(n);
-        return (0U < n);
+        return advance(e.stringify(rest));
     }
 
     bool visit(int i) override {
-        char *first = rest.data();
-        char *last = rest.data() + rest.size();
-        auto rc = std::to_chars(first, last, i);
-        auto success = (std::errc{} == rc.ec);
-        if (success) {
-            auto len = static_cast<std::size_t>(rc.ptr - first);
-            rest = rest.subspan(len);
+        return writeNumber(i);
+    }
+
+    bool visit(int64_t i) override {
+        return writeNumber(i);
+    }
+
+    bool visit(uint32_t u) override {
+        return writeNumber(u);
+    }
+
+    bool visit(const Core::Hex &h) override {
+        std::array<char, 12U> tmp{};
+        size_t n = 0U;
+        std::array<char, 8U> digits{};
+        auto rc = std::to_chars(digits.data(), digits.data() + digits.size(), h.value, 16);
+        const auto len = static_cast<size_t>(rc.ptr - digits.data());
+
+        if (h.quoted) {
+            tmp[n++] = '"';
         }
-        return success;
+        for (size_t pad = len; pad < std::min<size_t>(h.width, digits.size()); ++pad) {
+            tmp[n++] = '0';
+        }
+        for (size_t i = 0U; i < len; ++i) {
+            const char c = digits[i];
+            tmp[n++] = (('a' <= c) && (c <= 'f')) ? static_cast<char>(c - 'a' + 'A') : c;
+        }
+        if (h.quoted) {
+            tmp[n++] = '"';
+        }
+        return put(Core::ReadOnlyText{tmp.data(), n});
+    }
+
+    bool visit(const Core::FixedPoint &f) override {
+        if (Core::FixedPoint::MaxDecimals < f.decimals) {
+            return false;
+        }
+        uint64_t scale = 1U;
+        for (uint8_t i = 0U; i < f.decimals; ++i) {
+            scale *= 10U;
+        }
+        const uint64_t magnitude =
+            (f.raw < 0) ? (0U - static_cast<uint64_t>(f.raw)) : static_cast<uint64_t>(f.raw);
+
+        std::array<char, 48U> tmp{};
+        char *first = tmp.data();
+        char *last = tmp.data() + tmp.size();
+        if (f.raw < 0) {
+            *first++ = '-';
+        }
+        first = std::to_chars(first, last, magnitude / scale).ptr;
+        if (0U < f.decimals) {
+            *first++ = '.';
+            auto frac = magnitude % scale;
+            for (auto i = f.decimals; 0U < i; --i) {
+                first[i - 1U] = static_cast<char>('0' + (frac % 10U));
+                frac /= 10U;
+            }
+            first += f.decimals;
+        }
+        return put(Core::ReadOnlyText{tmp.data(), static_cast<size_t>(first - tmp.data())});
+    }
+
+    bool visit(double d) override {
+        return writeNumber(d);
     }
 
     std::size_t written() const override {
@@ -73,6 +133,42 @@ class Serializer : public Core::ACommandVisitor {
     }
 
   private:
+    bool advance(size_t n) {
+        rest = rest.subspan(n);
+        terminate();
+        return (0U < n);
+    }
+
+    void terminate() {
+        if (0U < rest.size()) {
+            rest[0] = '\0';
+        }
+    }
+
+    template <typename T>
+    bool writeNumber(T value) {
+        if (rest.empty()) {
+            return false;
+        }
+        char *first = rest.data();
+        char *last = rest.data() + rest.size() - 1U;
+        auto rc = std::to_chars(first, last, value);
+        auto success = (std::errc{} == rc.ec);
+        if (success) {
+            advance(static_cast<std::size_t>(rc.ptr - first));
+        }
+        return success;
+    }
+
+    bool put(Core::ReadOnlyText txt) {
+        const bool success = (txt.size() < rest.size());
+        if (success) {
+            std::copy_n(txt.data(), txt.size(), rest.data());
+            advance(txt.size());
+        }
+        return success;
+    }
+
     size_t writeQuoted(Core::MutableBuffer out, Core::ReadOnlyText txt) {
         std::size_t extra = 0U;
         for (char c : txt)
@@ -0,0 +1,222 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ATL_NS {
+namespace Utils {
+
+// Hierarchical timing wheel over abstract ticks: Levels wheels of 64 slots,
+// each slot of a level spanning a whole turn of the level below. Insert and
+// remove are O(1) on intrusive nodes; a timer is moved down one level each
+// time its slot comes up, until it lands in the first level and expires.
+// Deadlines beyond the top level are parked in its farthest slot and
+// placed again from there, which takes a level above the first one.
+template <std::size_t Levels = 4U>
+class TimingWheel {
+    static_assert((2U <= Levels) && (Levels <= 10U), "Levels must be within 2..10");
+
+    static constexpr unsigned SlotBits = 6U;
+    static constexpr std::size_t Slots = std::size_t{1U} << SlotBits;
+    static constexpr uint64_t SlotMask = Slots - 1U;
+    static constexpr uint8_t Expired = Levels;
+
+  public:
+    static constexpr uint64_t Never = std::numeric_limits<uint64_t>::max();
+
+    class Node {
+      public:
+        bool linked() const {
+            return nullptr != prev;
+        }
+
+        uint64_t deadline() const {
+            return expiry;
+        }
+
+      private:
+        friend class TimingWheel;
+        Node *prev{nullptr};
+        Node *next{nullptr};
+        uint64_t expiry{0U};
+        uint8_t level{0U};
+        uint8_t slot{0U};
+    };
+
+    explicit TimingWheel(uint64_t now = 0U) : current{now} {
+        for (auto &level : slots) {
+            for (auto &head : level) {
+                head.prev = head.next = &head;
+            }
+        }
+        expired.prev = expired.next = &expired;
+    }
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator=(const TimingWheel &) = delete;
+
+    // A deadline that is already due expires with the next advance().
+    void insert(Node &node, uint64_t deadline) {
+        remove(node);
+        node.expiry = deadline;
+        place(node, (deadline <= current) ? current + 1U : deadline);
+    }
+
+    void remove(Node &node) {
+        if (!node.linked())
+            return;
+        node.prev->next = node.next;
+        node.next->prev = node.prev;
+        if ((node.level < Levels) && isEmpty(slots[node.level][node.slot])) {
+            occupied[node.level] &= ~(uint64_t{1U} << node.slot);
+        }
+        node.prev = node.next = nullptr;
+    }
+
+    // Moves time forward to now. Nodes that fall due are queued for
+    // popExpired(). Stretches without work are skipped in one step.
+    void advance(uint64_t now) {
+        while (current < now) {
+            const uint64_t next = nextEvent();
+            if (now < next) {
+                current = now;
+                break;
+            }
+            current = next;
+            cascade();
+            collect();
+        }
+    }
+
+    Node *popExpired() {
+        if (isEmpty(expired))
+            return nullptr;
+        Node *node = expired.next;
+        remove(*node);
+        return node;
+    }
+
+    // Tick at which advance() has work to do next, or Never.
+    uint64_t nextEvent() const {
+        uint64_t best = Never;
+        for (std::size_t level = 0U; level < Levels; ++level) {
+            if (0U == occupied[level])
+                continue;
+            const unsigned shift = SlotBits * static_cast<unsigned>(level);
+            const uint64_t base = (current >> shift) + 1U;
+            const uint64_t distance = distanceTo(occupied[level], base & SlotMask);
+            const uint64_t tick = (base + distance) << shift;
+            if (tick < best) {
+                best = tick;
+            }
+        }
+        return best;
+    }
+
+    uint64_t now() const {
+        return current;
+    }
+
+    bool empty() const {
+        for (const auto bits : occupied) {
+            if (0U != bits)
+                return false;
+        }
+        return isEmpty(expired);
+    }
+
+  private:
+    static bool isEmpty(const Node &head) {
+        return head.next == &head;
+    }
+
+    // Slots from start to the first occupied one, going round.
+    static uint64_t distanceTo(uint64_t bits, uint64_t start) {
+        const uint64_t rotated =
+            (0U == start) ? bits : ((bits >> start) | (bits << (Slots - start)));
+        return static_cast<uint64_t>(__builtin_ctzll(rotated));
+    }
+
+    static void link(Node &head, Node &node) {
+        node.prev = head.prev;
+        node.next = &head;
+        head.prev->next = &node;
+        head.prev = &node;
+    }
+
+    // when may equal current only while that tick is being processed.
+    void place(Node &node, uint64_t when) {
+        std::size_t level = 0U;
+        uint64_t slot = 0U;
+        for (; level < Levels; ++level) {
+            const unsigned shift = SlotBits * static_cast<unsigned>(level);
+            if (((when >> shift) - (current >> shift)) < Slots) {
+                slot = (when >> shift) & SlotMask;
+                break;
+            }
+        }
+        if (Levels == level) {
+            level = Levels - 1U;
+            const unsigned shift = SlotBits * static_cast<unsigned>(level);
+            slot = ((current >> shift) + SlotMask) & SlotMask;
+        }
+
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        link(slots[level][slot], node);
+        occupied[level] |= uint64_t{1U} << slot;
+    }
+
+    // Higher levels first, so their nodes can drop through several levels
+    // at a common boundary.
+    void cascade() {
+        for (std::size_t level = Levels - 1U; 0U < level; --level) {
+            const unsigned shift = SlotBits * static_cast<unsigned>(level);
+            if (0U != (current & ((uint64_t{1U} << shift) - 1U)))
+                continue;
+            const auto slot = static_cast<std::size_t>((current >> shift) & SlotMask);
+            Node &head = slots[level][slot];
+            while (!isEmpty(head)) {
+                Node &node = *head.next;
+                remove(node);
+                place(node, (node.expiry < current) ? current : node.expiry);
+            }
+        }
+    }
+
+    void collect() {
+        Node &head = slots[0U][current & SlotMask];
+        while (!isEmpty(head)) {
+            Node &node = *head.next;
+            remove(node);
+            node.level = Expired;
+            link(expired, node);
+        }
+    }
+
+    uint64_t current;
+    std::array<std::array<Node, Slots>, Levels> slots{};
+    std::array<uint64_t, Levels> occupied{};
+    Node expired{};
+};
+
+} // namespace Utils
+} // namespace ATL_NS
@@ -0,0 +1,97 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Time spent in the logging thread per line: a text line handed to the
+// AsyncLogger against the same line stored in the binary log. Writes the
+// binary log to ATLINK_BLOG, or to /tmp/bmBinaryLog.blog if unset, which
+// scripts/atlinklog can decode afterwards.
+
+#include "atlink/platform/api/BinaryLog.h"
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/BinaryLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using namespace ATL_NS::Platform;
+using Clock = std::chrono::steady_clock;
+using BinaryLog = Api::BinaryLog<Impl::Linux::BinaryLog>;
+
+constexpr std::size_t Lines = 20'000U;
+
+template <typename Log>
+void run(const char *name, Log &&log) {
+    std::vector<uint64_t> latencies;
+    latencies.reserve(Lines);
+    for (std::size_t i = 0U; i < Lines; ++i) {
+        const auto start = Clock::now();
+        log(i);
+        latencies.push_back(static_cast<uint64_t>((Clock::now() - start).count()));
+        // Pace the lines like a busy FSM, not a tight loop.
+        if (0U == (i % 64U)) {
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-8s p50 %8llu ns  p99 %10llu ns  max %10llu ns\n",
+                name,
+                (unsigned long long)latencies[Lines / 2U],
+                (unsigned long long)latencies[Lines * 99U / 100U],
+                (unsigned long long)latencies.back());
+}
+
+} // namespace
+
+int main() {
+    ::setenv("ATLINK_BLOG", "/tmp/bmBinaryLog.blog", 0);
+    if (!BinaryLog::enabled()) {
+        std::fprintf(stderr, "cannot open %s\n", std::getenv("ATLINK_BLOG"));
+        return 1;
+    }
+
+    // Text lines are not what is measured here; keep the terminal quiet.
+    const int null = ::open("/dev/null", O_WRONLY);
+    ::dup2(null, STDERR_FILENO);
+
+    Api::Logger<Impl::Linux::AsyncLogger> logger{"bench"};
+    logger.setLogLevel(Api::Log::Level::Trace);
+    constexpr std::string_view Data{"\r\n+CSQ: 21,99\r\n\r\nOK\r\n"};
+
+    // Cost of the clock reads around each line.
+    run("none", [](std::size_t) {});
+    run("text", [&logger](std::size_t i) { logger.trace() << "rx read " << i << " bytes"; });
+    run("binary", [&logger](std::size_t i) {
+        ATL_BLOG_TO(BinaryLog, logger, Trace, "rx read %zu bytes", i);
+    });
+    run("text+s", [&logger, Data](std::size_t) { logger.debug() << "tty-rx: data=" << Data; });
+    run("binary+s", [&logger, Data](std::size_t) {
+        ATL_BLOG_TO(BinaryLog, logger, Debug, "%s: data=%s", "tty-rx", Data);
+    });
+
+    std::printf("binary records dropped: %llu\n", (unsigned long long)BinaryLog::dropped());
+    return 0;
+}
@@ -0,0 +1,83 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Command round trip as sendCommand does it: the caller hands a request
+// to a worker thread through the MessageQueue and waits for the reply on
+// a primitive constructed per call. Compares Completion with Semaphore.
+
+#include "atlink/platform/linux/Completion.h"
+#include "atlink/platform/linux/MessageQueue.h"
+#include "atlink/platform/linux/Semaphore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+using namespace ATL_NS::Platform::Impl::Linux;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t RoundTrips = 200'000U;
+
+void signal(Completion &c) {
+    c.complete();
+}
+
+void signal(Semaphore &s) {
+    s.release();
+}
+
+void waitFor(Completion &c) {
+    c.wait();
+}
+
+void waitFor(Semaphore &s) {
+    s.acquire();
+}
+
+template <typename Primitive>
+void run(const char *name) {
+    MessageQueue<Primitive *> requests;
+    std::thread worker([&requests] {
+        while (auto *reply = requests.get()) {
+            signal(*reply);
+        }
+    });
+
+    const auto start = Clock::now();
+    for (std::size_t i = 0U; i < RoundTrips; ++i) {
+        Primitive reply{};
+        requests.put(&reply);
+        waitFor(reply);
+    }
+    const auto elapsed = Clock::now() - start;
+
+    requests.put(nullptr);
+    worker.join();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::printf("%-12s %8.0f ns/round trip\n", name, static_cast<double>(ns) / RoundTrips);
+}
+
+} // namespace
+
+int main() {
+    run<Completion>("completion");
+    run<Semaphore>("semaphore");
+    return 0;
+}
@@ -0,0 +1,171 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// AT/OK round trips over a pty through each Linux DeviceIO backend: wall
+// time, CPU time and context switches per 1k commands. CPU includes the
+// thread answering on the master side, which is the same for all. Syscall
+// counts are best taken per backend with strace, e.g.
+//   strace -c -f bin/bmDeviceIO uring 2>&1 >/dev/null | tail -n 20
+// The backends log to stderr, which is discarded.
+
+#include "atlink/platform/linux/DeviceIO.h"
+#include "atlink/platform/linux/EpollDeviceIO.h"
+#include "atlink/platform/linux/UringDeviceIO.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <string_view>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+using ATL_NS::Platform::Api::Subscriber;
+
+constexpr std::size_t Commands = 5000U;
+constexpr std::string_view Request = "AT\r";
+constexpr std::string_view Reply = "\r\nOK\r\n";
+
+// Modem stand-in on the master side of the pty.
+class Responder {
+  public:
+    explicit Responder(int master) : master{master}, worker{&Responder::loop, this} {}
+    ~Responder() {
+        run = false;
+        worker.join();
+    }
+
+  private:
+    void loop() {
+        std::array<char, 64U> buf;
+        while (run) {
+            pollfd pfd{master, POLLIN, 0};
+            if (::poll(&pfd, 1, 50) <= 0)
+                continue;
+            const ssize_t n = ::read(master, buf.data(), buf.size());
+            for (ssize_t i = 0; i < n; ++i) {
+                if ('\r' == buf[static_cast<std::size_t>(i)]) {
+                    (void)!::write(master, Reply.data(), Reply.size());
+                }
+            }
+        }
+    }
+
+    int master;
+    std::atomic<bool> run{true};
+    std::thread worker;
+};
+
+class Waiter : public Subscriber {
+  public:
+    void notify(Event ev) override {
+        if (Event::RxReady == ev) {
+            std::lock_guard<std::mutex> lk(mtx);
+            ready = true;
+            cv.notify_one();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait(lk, [this] { return ready; });
+        ready = false;
+    }
+
+  private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool ready{false};
+};
+
+double seconds(const timeval &tv) {
+    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+}
+
+template <typename IO>
+void run(const char *name) {
+    IO io;
+    Waiter waiter;
+    io.subscribe(waiter);
+
+    rusage before{};
+    ::getrusage(RUSAGE_SELF, &before);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::array<char, 64U> buf;
+    for (std::size_t i = 0U; i < Commands; ++i) {
+        io.write(Request);
+        std::size_t received = 0U;
+        while (received < Reply.size()) {
+            waiter.wait();
+            received += io.read(buf);
+        }
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    rusage after{};
+    ::getrusage(RUSAGE_SELF, &after);
+
+    const double perK = 1000.0 / Commands;
+    const double wall = std::chrono::duration<double>(elapsed).count();
+    const double cpu = (seconds(after.ru_utime) - seconds(before.ru_utime)) +
+                       (seconds(after.ru_stime) - seconds(before.ru_stime));
+    const long switches = (after.ru_nvcsw - before.ru_nvcsw) + (after.ru_nivcsw - before.ru_nivcsw);
+    std::printf("%-6s %8.2f ms wall  %8.2f ms cpu  %8.0f ctx switches  per 1k commands\n",
+                name,
+                wall * 1e3 * perK,
+                cpu * 1e3 * perK,
+                static_cast<double>(switches) * perK);
+}
+
+bool selected(int argc, char **argv, const char *name) {
+    return (argc < 2) || (0 == std::strcmp(argv[1], name));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (::grantpt(master) != 0) || (::unlockpt(master) != 0)) {
+        std::perror("pty");
+        return 1;
+    }
+    ::setenv("ATLINK_TTY", ::ptsname(master), 1);
+    if (nullptr == std::freopen("/dev/null", "w", stderr)) {
+        return 1;
+    }
+
+    Responder responder{master};
+
+    if (selected(argc, argv, "poll"))
+        run<ATL_NS::Platform::Impl::Linux::DeviceIO>("poll");
+    if (selected(argc, argv, "epoll"))
+        run<ATL_NS::Platform::Impl::Linux::EpollDeviceIO>("epoll");
+    if (selected(argc, argv, "uring"))
+        run<ATL_NS::Platform::Impl::Linux::UringDeviceIO>("uring");
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Numeric enum parse throughput: the dense bitmap of EnumStringConverter
+// against a plain magic_enum::enum_cast on the same input.
+
+#include "atlink/utils/EnumStringConverter.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+enum class CmsCode {
+    MeFailure = 300,
+    SmsServiceReserved = 301,
+    OperationNotAllowed = 302,
+    OperationNotSupported = 303,
+    InvalidPduMode = 304,
+    InvalidTextMode = 305,
+    SimNotInserted = 310,
+    SimPinRequired = 311,
+    MemoryFailure = 320,
+    InvalidMemoryIndex = 321,
+    MemoryFull = 322,
+    SmscAddressUnknown = 330,
+    NoNetworkService = 331,
+    NetworkTimeout = 332,
+    Unknown = 500,
+};
+
+} // namespace
+
+template <>
+struct magic_enum::customize::enum_range<CmsCode> {
+    static constexpr int min = 0;
+    static constexpr int max = 511;
+};
+
+namespace {
+
+constexpr std::array<std::string_view, 8U> inputs = {
+    "300", "311", "322", "500", "332", "299", "400", "305",
+};
+
+constexpr std::size_t Iterations = 10'000'000U;
+
+template <typename Parse>
+void run(const char *name, Parse &&parse) {
+    std::size_t accepted = 0U;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0U; i < Iterations; ++i) {
+        accepted += parse(inputs[i % inputs.size()]);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::printf("%-12s %8.2f ns/parse  (%zu accepted)\n",
+                name,
+                static_cast<double>(ns) / Iterations,
+                accepted);
+}
+
+} // namespace
+
+int main() {
+    static constexpr atlink::Utils::EnumStringConverter<CmsCode> converter{};
+
+    run("bitmap", [](std::string_view in) -> std::size_t {
+        CmsCode code{};
+        return (0U < converter.parse(code, in)) ? 1U : 0U;
+    });
+
+    run("enum_cast", [](std::string_view in) -> std::size_t {
+        int num = 0;
+        std::from_chars(in.data(), in.data() + in.size(), num);
+        return magic_enum::enum_cast<CmsCode>(num).has_value() ? 1U : 0U;
+    });
+
+    return 0;
+}
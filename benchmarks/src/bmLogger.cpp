@@ -0,0 +1,89 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Time spent in the logging thread per line, synchronous Logger against
+// AsyncLogger, with stderr going into a pipe that a slow reader drains
+// like a serial console would.
+
+#include "atlink/platform/linux/AsyncLogger.h"
+#include "atlink/platform/linux/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using namespace ATL_NS::Platform;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t Lines = 20'000U;
+
+template <typename Backend>
+void run(const char *name) {
+    Api::Logger<Backend> logger{"bench"};
+    logger.setLogLevel(Api::Log::Level::Trace);
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(Lines);
+    for (std::size_t i = 0U; i < Lines; ++i) {
+        const auto start = Clock::now();
+        logger.trace() << "rx read " << i << " bytes";
+        latencies.push_back(static_cast<uint64_t>((Clock::now() - start).count()));
+        // Pace the lines like a busy FSM, not a tight loop.
+        if (0U == (i % 64U)) {
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-6s p50 %8llu ns  p99 %10llu ns  max %10llu ns\n",
+                name,
+                (unsigned long long)latencies[Lines / 2U],
+                (unsigned long long)latencies[Lines * 99U / 100U],
+                (unsigned long long)latencies.back());
+}
+
+} // namespace
+
+int main() {
+    std::array<int, 2U> fds{};
+    if (::pipe(fds.data()) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+    ::dup2(fds[1], STDERR_FILENO);
+
+    // About 1 MB/s. Keeps reading until exit, when the sink flushes.
+    std::thread([reader = fds[0]] {
+        std::array<char, 1024U> buf;
+        while (0 < ::read(reader, buf.data(), buf.size())) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }).detach();
+
+    run<Impl::Linux::Logger>("sync");
+    run<Impl::Linux::AsyncLogger>("async");
+    std::printf("async lines dropped: %llu\n",
+                (unsigned long long)Impl::Linux::LogSink::instance().dropped());
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// MessageQueue hand-off with 1 to 16 producers and one consumer: the
+// lock-free ring against the mutex, condition variable and deque it
+// replaced. Messages carry their put time for the latency figures.
+
+#include "atlink/platform/linux/MessageQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t Messages = 1'000'000U;
+
+// The previous Linux backend.
+template <typename T>
+class LockedQueue {
+  public:
+    void put(T msg) {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            queue.push_back(std::move(msg));
+        }
+        condvar.notify_one();
+    }
+
+    T get() {
+        std::unique_lock<std::mutex> lk(mutex);
+        condvar.wait(lk, [this] { return !queue.empty(); });
+        T v = std::move(queue.front());
+        queue.pop_front();
+        return v;
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable condvar;
+    std::deque<T> queue;
+};
+
+uint64_t stamp() {
+    return static_cast<uint64_t>(Clock::now().time_since_epoch().count());
+}
+
+template <typename Queue>
+void run(const char *name, std::size_t producers) {
+    Queue queue;
+    const std::size_t perProducer = Messages / producers;
+    const std::size_t total = perProducer * producers;
+    std::vector<uint64_t> latencies;
+    latencies.reserve(total);
+
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0U; p < producers; ++p) {
+        threads.emplace_back([&queue, perProducer] {
+            for (std::size_t i = 0U; i < perProducer; ++i) {
+                queue.put(stamp());
+            }
+        });
+    }
+    for (std::size_t i = 0U; i < total; ++i) {
+        const uint64_t sent = queue.get();
+        latencies.push_back(stamp() - sent);
+    }
+    const auto elapsed = Clock::now() - start;
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-8s %2zu producers  %6.2f M msg/s  p50 %8.0f ns  p99 %10.0f ns\n",
+                name,
+                producers,
+                static_cast<double>(total) / seconds / 1e6,
+                static_cast<double>(latencies[total / 2U]),
+                static_cast<double>(latencies[total * 99U / 100U]));
+}
+
+} // namespace
+
+int main() {
+    for (const std::size_t producers : {1U, 2U, 4U, 8U, 16U}) {
+        run<ATL_NS::Platform::Impl::Linux::MessageQueue<uint64_t>>("ring", producers);
+        run<LockedQueue<uint64_t>>("locked", producers);
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Timer throughput: start/stop pairs on the wheel against a thread spawned
+// per start as the previous backend did, then many timers firing at once
+// with their lateness.
+
+#include "atlink/platform/linux/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ATL_NS::Platform::Impl::Linux::Timer;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t Restarts = 200'000U;
+constexpr std::size_t ThreadRestarts = 20'000U;
+constexpr std::size_t Fired = 100'000U;
+
+double rate(std::size_t n, Clock::duration elapsed) {
+    return static_cast<double>(n) / std::chrono::duration<double>(elapsed).count();
+}
+
+void wheelRestarts() {
+    Timer timer;
+    const auto start = Clock::now();
+    for (std::size_t i = 0U; i < Restarts; ++i) {
+        timer.start(std::chrono::seconds{1});
+        timer.stop();
+    }
+    std::printf("wheel start/stop   %12.0f per s\n", rate(Restarts, Clock::now() - start));
+}
+
+// What every start/stop used to cost.
+void threadRestarts() {
+    std::mutex mtx;
+    std::condition_variable cv;
+    const auto start = Clock::now();
+    for (std::size_t i = 0U; i < ThreadRestarts; ++i) {
+        bool stopped = false;
+        std::thread worker([&] {
+            std::unique_lock<std::mutex> lk(mtx);
+            cv.wait_for(lk, std::chrono::seconds{1}, [&] { return stopped; });
+        });
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stopped = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+    std::printf("thread start/stop  %12.0f per s\n", rate(ThreadRestarts, Clock::now() - start));
+}
+
+struct Probe {
+    Timer timer;
+    Clock::time_point due;
+    std::atomic<std::size_t> *count;
+    std::atomic<int64_t> *lateness;
+};
+
+void onFire(void *ctx) {
+    auto &probe = *static_cast<Probe *>(ctx);
+    const auto late =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - probe.due);
+    probe.lateness->fetch_add(late.count(), std::memory_order_relaxed);
+    probe.count->fetch_add(1U, std::memory_order_release);
+}
+
+void wheelFiring() {
+    std::atomic<std::size_t> count{0U};
+    std::atomic<int64_t> lateness{0};
+    std::vector<std::unique_ptr<Probe>> probes(Fired);
+
+    const auto start = Clock::now();
+    for (std::size_t i = 0U; i < Fired; ++i) {
+        probes[i] = std::make_unique<Probe>();
+        auto &probe = *probes[i];
+        probe.count = &count;
+        probe.lateness = &lateness;
+        probe.timer.setHandler(onFire, &probe);
+        const auto d = std::chrono::milliseconds{1 + static_cast<int>(i % 50U)};
+        probe.due = Clock::now() + d;
+        probe.timer.start(d);
+    }
+    while (count.load(std::memory_order_acquire) < Fired) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    const auto elapsed = Clock::now() - start;
+
+    std::printf("wheel fired        %12.0f per s  (avg %.0f us late)\n",
+                rate(Fired, elapsed),
+                static_cast<double>(lateness.load()) / Fired);
+}
+
+} // namespace
+
+int main() {
+    wheelRestarts();
+    threadRestarts();
+    wheelFiring();
+    return 0;
+}
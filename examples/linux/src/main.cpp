@@ -103,8 +103,8 @@ int main() {
     // Install Ctrl-C handler
     ::signal(SIGINT, sigintHandler);
 
+    // The log level is taken from ATLINK_LOG_LEVEL, e.g. ATLINK_LOG_LEVEL=trace.
     ATL_NS::Platform::Logger logger{"main"};
-    logger.setLogLevel(ATL_NS::Platform::Api::Log::Level::Trace);
     logger.info() << "Atlink demo app started ...";
 
     logger.error() << "error message";
@@ -126,11 +126,11 @@ int main() {
     }
 
     const std::string &tty = ports[static_cast<size_t>(choice)];
-    ::setenv("ATLINK_TTY", tty.c_str(), 1);
     std::cout << "Using port: " << tty << "\n";
 
-    // DeviceIO backend is expected to read ATLINK_TTY
-    auto deviceIO = atlink::Platform::DeviceIO{};
+    auto serial = atlink::Platform::SerialConfig{};
+    serial.port = tty.c_str();
+    auto deviceIO = atlink::Platform::DeviceIO{serial};
     auto urcDispatcher = UrcDispatcher{};
     auto device = atlink::Core::Device{"mc60", deviceIO, urcDispatcher};
 
@@ -0,0 +1,160 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/platform/api/BinaryLog.h"
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace {
+
+namespace Blog = ATL_NS::Platform::Api::Blog;
+
+template <typename... Args>
+std::string render(const char *format, const Args &...args) {
+    Blog::Text text{format};
+    (text.add(args), ...);
+    return std::string{text.finish()};
+}
+
+template <typename T>
+T decode(const char *in) {
+    T value{};
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+SCENARIO("Binary log lines are rendered as text without a log open") {
+
+    GIVEN("Arguments of every supported type") {
+        WHEN("Rendered") {
+            auto text = render("%d %u %x %5.2f %c %s", -3, 7U, 255, 3.14159, 'A', true);
+            THEN("Each takes the next conversion of the format") {
+                REQUIRE("-3 7 ff  3.14 A true" == text);
+            }
+        }
+
+        WHEN("The format carries length modifiers") {
+            auto text = render("%zu bytes, %lld", std::size_t{42U}, int64_t{-5});
+            THEN("They are ignored in favour of the argument types") {
+                REQUIRE("42 bytes, -5" == text);
+            }
+        }
+    }
+
+    GIVEN("A format with an escaped percent sign") {
+        WHEN("Rendered") {
+            auto text = render("%d%% done", 100);
+            THEN("A single percent sign is written") {
+                REQUIRE("100% done" == text);
+            }
+        }
+    }
+
+    GIVEN("A string with control characters") {
+        WHEN("Rendered") {
+            auto text = render("data=%s", "AT\r\nOK\x01");
+            THEN("They are escaped like tty data") {
+                REQUIRE("data=AT<CR><LF>OK<0x01>" == text);
+            }
+        }
+    }
+
+    GIVEN("A format whose conversions do not match the arguments") {
+        WHEN("There are fewer arguments than conversions") {
+            auto text = render("a=%d b=%d", 1);
+            THEN("The unused conversions are dropped") {
+                REQUIRE("a=1 b=" == text);
+            }
+        }
+
+        WHEN("There are more arguments than conversions") {
+            auto text = render("a=%d", 1, 2);
+            THEN("The surplus arguments are ignored") {
+                REQUIRE("a=1" == text);
+            }
+        }
+    }
+
+    GIVEN("A line longer than the text buffer") {
+        const std::string data(300U, 'x');
+        WHEN("Rendered") {
+            auto text = render("%s", data);
+            THEN("It is cut to fit, leaving room for the terminator") {
+                REQUIRE((Blog::Text::SIZE - 1U) == text.size());
+                REQUIRE(std::string(Blog::Text::SIZE - 1U, 'x') == text);
+            }
+        }
+    }
+}
+
+SCENARIO("Binary log arguments are encoded by type") {
+
+    GIVEN("Arguments of every supported type") {
+        THEN("The signature lists their type codes") {
+            using Signature = Blog::Signature<int, uint64_t, double, const char *, bool, char>;
+            REQUIRE(std::string{"iUdsbc"} == Signature::codes);
+        }
+
+        THEN("Their encoded sizes follow the type codes") {
+            REQUIRE(4U == Blog::encodedSize(int16_t{1}));
+            REQUIRE(4U == Blog::encodedSize(1U));
+            REQUIRE(8U == Blog::encodedSize(int64_t{1}));
+            REQUIRE(8U == Blog::encodedSize(1.0));
+            REQUIRE(1U == Blog::encodedSize('c'));
+            REQUIRE(1U == Blog::encodedSize(true));
+            REQUIRE(5U == Blog::encodedSize("abc"));
+        }
+    }
+
+    GIVEN("A record with an integer, a string and a double") {
+        char buf[32U]{};
+        char *out = Blog::encode(buf, int32_t{-2});
+        out = Blog::encode(out, std::string_view{"hi"});
+        out = Blog::encode(out, 2.5);
+
+        THEN("The values are stored back to back") {
+            REQUIRE(16U == static_cast<std::size_t>(out - buf));
+            REQUIRE(-2 == decode<int32_t>(buf));
+            REQUIRE(2U == decode<uint16_t>(buf + 4U));
+            REQUIRE(0 == std::memcmp("hi", buf + 6U, 2U));
+            REQUIRE(2.5 == decode<double>(buf + 8U));
+        }
+
+        THEN("The record size is padded to 8 bytes") {
+            const auto size = sizeof(Blog::RecordHeader) + 4U + Blog::encodedSize("hi");
+            REQUIRE(16U == sizeof(Blog::RecordHeader));
+            REQUIRE(24U == Blog::align8(size));
+        }
+    }
+
+    GIVEN("A string longer than MaxString") {
+        const std::string data(Blog::MaxString + 10U, 'x');
+        THEN("Only MaxString bytes are encoded") {
+            REQUIRE((2U + Blog::MaxString) == Blog::encodedSize(data));
+
+            std::string buf(Blog::MaxString + 16U, '\0');
+            char *out = Blog::encode(&buf[0], data);
+            REQUIRE(Blog::MaxString == decode<uint16_t>(buf.data()));
+            REQUIRE((2U + Blog::MaxString) == static_cast<std::size_t>(out - buf.data()));
+        }
+    }
+}
@@ -16,6 +16,9 @@
 //
 
 #include "atlink/core/Command.h"
+#include "atlink/core/PreparedCommand.h"
+#include "atlink/protocols/standard/Ipr.h"
+#include "atlink/utils/GatherSerializer.h"
 #include "atlink/utils/Serializer.h"
 
 #include <catch2/catch_all.hpp>
@@ -40,6 +43,41 @@ class TestCommand : public ATL_NS::Core::Command {
     }
 };
 
+class OptionalCommand : public ATL_NS::Core::Command {
+  public:
+    int n{2};
+    ATL_NS::Core::Optional<int> a{};
+    ATL_NS::Core::Optional<int> b{};
+
+    OptionalCommand() : ATL_NS::Core::Command("AT+TEST=") {}
+    bool accept(ATL_NS::Core::ACommandVisitor &visitor) const override {
+        return Command::acceptImpl(visitor, n, a, b);
+    }
+};
+
+class SendCommand : public ATL_NS::Core::Command {
+  public:
+    int length{0};
+    std::string data{};
+    ATL_NS::Core::ReadOnlyText view{};
+
+    SendCommand() : ATL_NS::Core::Command("AT+QISEND=0,") {}
+    bool accept(ATL_NS::Core::ACommandVisitor &visitor) const override {
+        return Command::acceptImpl(visitor, length);
+    }
+    gsl::span<const ATL_NS::Core::ReadOnlyText> payload() const override {
+        return {&view, 1U};
+    }
+};
+
+std::string join(gsl::span<const ATL_NS::Core::ReadOnlyText> chunks) {
+    std::string out{};
+    for (const auto &chunk : chunks) {
+        out.append(chunk.data(), chunk.size());
+    }
+    return out;
+}
+
 } // namespace
 
 template <>
@@ -73,4 +111,193 @@ SCENARIO("Command can accept visitor") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Command with optional fields omits the absent trailing ones") {
+
+    GIVEN("A command with two optional fields") {
+        auto cmd = OptionalCommand{};
+        char buf[32U];
+        auto serializer = ATL_NS::Utils::Serializer{buf};
+
+        WHEN("No optional field is set") {
+            cmd.accept(serializer);
+            THEN("Neither the fields nor their commas are written") {
+                REQUIRE(std::string{"AT+TEST=2\r"} == buf);
+            }
+        }
+
+        WHEN("Only the last optional field is set") {
+            cmd.b = 5;
+            cmd.accept(serializer);
+            THEN("The absent field in the middle is left empty") {
+                REQUIRE(std::string{"AT+TEST=2,,5\r"} == buf);
+            }
+        }
+    }
+}
+
+SCENARIO("Prepared command serializes its constant part once") {
+
+    GIVEN("A command with a fixed argument and a changing one") {
+        ATL_NS::Core::PreparedCommand<16U, int> cmd{"AT+QIRD=", 0};
+
+        THEN("The constant part is serialized on construction") {
+            REQUIRE(std::string_view{"AT+QIRD=0,"} == cmd.constantPart());
+        }
+
+        WHEN("Serialized twice with different values") {
+            char first[32U];
+            char second[32U];
+            cmd.arg<0>() = 1500;
+            auto s1 = ATL_NS::Utils::Serializer{first};
+            REQUIRE(cmd.accept(s1));
+            cmd.arg<0>() = 64;
+            auto s2 = ATL_NS::Utils::Serializer{second};
+            REQUIRE(cmd.accept(s2));
+
+            THEN("Only the changing argument differs") {
+                REQUIRE(std::string{"AT+QIRD=0,1500\r"} == first);
+                REQUIRE(std::string{"AT+QIRD=0,64\r"} == second);
+            }
+        }
+    }
+
+    GIVEN("Storage too small for the tag and the fixed arguments") {
+        const ATL_NS::Core::PreparedCommand<8U, int> cmd{"AT+QIRD=", 0};
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("Nothing is written") {
+                REQUIRE_FALSE(cmd.valid());
+                REQUIRE_FALSE(success);
+                REQUIRE(0U == serializer.written());
+            }
+        }
+    }
+
+    GIVEN("A command without arguments") {
+        const ATL_NS::Core::PreparedCommand<1U> cmd{"AT+CSQ"};
+        WHEN("Serialized") {
+            char buf[16U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("The tag is emitted as is") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+CSQ\r"} == buf);
+                REQUIRE(7U == serializer.written());
+            }
+        }
+    }
+}
+
+SCENARIO("Serializer keeps its output terminated") {
+
+    GIVEN("A buffer filled with garbage") {
+        char buf[8U];
+        std::fill(std::begin(buf), std::end(buf), 'x');
+
+        WHEN("A short sequence is serialized") {
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            serializer.visit(ATL_NS::Core::Sequence{"AT"});
+            THEN("The output is terminated right after it") {
+                REQUIRE(std::string{"AT"} == buf);
+            }
+        }
+
+        WHEN("A number does not leave room for the terminator") {
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = serializer.visit(12345678);
+            THEN("It is rejected") {
+                REQUIRE_FALSE(success);
+                REQUIRE(0U == serializer.written());
+            }
+        }
+    }
+}
+
+SCENARIO("Command can be serialized into chunks for a vectored write") {
+
+    GIVEN("A command with strings, numbers and enums") {
+        auto cmd = TestCommand{};
+        cmd.str.stream() << "plain";
+        cmd.intEnum = TestCommand::IntEnum::Two;
+        cmd.strEnum = TestCommand::StrEnum::Seven;
+
+        WHEN("Serialized by both serializers") {
+            char buf[64U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            REQUIRE(cmd.accept(serializer));
+            auto gather = ATL_NS::Utils::GatherSerializer{};
+            auto success = cmd.accept(gather);
+
+            THEN("The chunks add up to the same bytes") {
+                REQUIRE(success);
+                REQUIRE(std::string{buf} == join(gather.output()));
+                REQUIRE(serializer.written() == gather.written());
+            }
+
+            THEN("The tag and the string are not copied") {
+                REQUIRE(cmd.tag.view().data() == gather.output()[0].data());
+                auto found = false;
+                for (const auto &chunk : gather.output()) {
+                    found = found || (chunk.data() == cmd.str.view().data());
+                }
+                REQUIRE(found);
+            }
+        }
+    }
+
+    GIVEN("A command whose string needs escaping") {
+        auto cmd = TestCommand{};
+        cmd.str.stream() << "test \"string\"";
+        WHEN("Serialized") {
+            char buf[64U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            REQUIRE(cmd.accept(serializer));
+            auto gather = ATL_NS::Utils::GatherSerializer{};
+            REQUIRE(cmd.accept(gather));
+            THEN("The escaped copy is sent") {
+                REQUIRE(std::string{buf} == join(gather.output()));
+            }
+        }
+    }
+
+    GIVEN("A command with a payload larger than any staging buffer") {
+        auto cmd = SendCommand{};
+        cmd.data.assign(4096U, 'x');
+        cmd.view = cmd.data;
+        cmd.length = static_cast<int>(cmd.data.size());
+
+        WHEN("Serialized") {
+            auto gather = ATL_NS::Utils::GatherSerializer{};
+            auto success = cmd.accept(gather);
+            for (const auto &chunk : cmd.payload()) {
+                success = success && gather.append(chunk);
+            }
+            THEN("The payload is appended in place") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+QISEND=0,4096\r"} + cmd.data == join(gather.output()));
+                REQUIRE(cmd.data.data() == gather.output()[gather.output().size() - 1U].data());
+            }
+        }
+    }
+}
+
+SCENARIO("Baud rate command can be serialized") {
+
+    GIVEN("An AT+IPR command for 3 Mbaud") {
+        auto cmd = ATL_NS::Proto::Std::Ipr::Write::Command{};
+        cmd.rate = 3000000U;
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("The rate is written in decimal") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+IPR=3000000\r"} == buf);
+            }
+        }
+    }
+}
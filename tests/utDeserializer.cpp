@@ -140,6 +140,73 @@ SCENARIO("Integer can be deserialized") {
     }
 }
 
+SCENARIO("Wide, unsigned, hex and decimal numbers can be deserialized") {
+
+    GIVEN("A 64-bit integer") {
+        atlink::Utils::Deserializer deserializer{" -9000000000,"};
+        int64_t value = 0;
+        auto success = deserializer.visit(value);
+        THEN("The full value is parsed") {
+            REQUIRE(success);
+            REQUIRE(-9000000000LL == value);
+            REQUIRE(12U == deserializer.consumed());
+        }
+    }
+
+    GIVEN("A negative number where an unsigned one is expected") {
+        atlink::Utils::Deserializer deserializer{"-1"};
+        uint32_t value = 7U;
+        auto success = deserializer.visit(value);
+        THEN("Deserialization fails") {
+            REQUIRE_FALSE(success);
+            REQUIRE(7U == value);
+        }
+    }
+
+    GIVEN("Unquoted hex digits") {
+        atlink::Utils::Deserializer deserializer{"ff01"};
+        atlink::Core::Hex value{};
+        auto success = deserializer.visit(value);
+        THEN("They are parsed as hex") {
+            REQUIRE(success);
+            REQUIRE(0xFF01U == value.value);
+            REQUIRE_FALSE(value.quoted);
+        }
+    }
+
+    GIVEN("Quoted hex digits without the closing quote") {
+        atlink::Utils::Deserializer deserializer{"\"1A2B"};
+        atlink::Core::Hex value{};
+        auto success = deserializer.visit(value);
+        THEN("Deserialization fails") {
+            REQUIRE_FALSE(success);
+            REQUIRE(0U == value.value);
+        }
+    }
+
+    GIVEN("A decimal with fewer digits than the fixed-point precision") {
+        atlink::Utils::Deserializer deserializer{"-0.5"};
+        atlink::Core::FixedPoint value{0, 3U};
+        auto success = deserializer.visit(value);
+        THEN("The value is scaled to the precision") {
+            REQUIRE(success);
+            REQUIRE(-500 == value.raw);
+            REQUIRE(4U == deserializer.consumed());
+        }
+    }
+
+    GIVEN("A decimal that does not fit once scaled to the precision") {
+        atlink::Utils::Deserializer deserializer{"1000000000000000.5"};
+        atlink::Core::FixedPoint value{7, 4U};
+        auto success = deserializer.visit(value);
+        THEN("Deserialization fails and the value is kept") {
+            REQUIRE_FALSE(success);
+            REQUIRE(7 == value.raw);
+            REQUIRE(0U == deserializer.consumed());
+        }
+    }
+}
+
 SCENARIO("Quoted string can be deserialized") {
 
     using atlink::Core::QuotedField;
@@ -334,4 +401,85 @@ SCENARIO("Deserializer can be rewound") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Deserializer resumes from the progress of an earlier attempt") {
+
+    using atlink::Core::Sequence;
+    const Sequence tag{"+CSQ:"};
+    const Sequence comma{","};
+
+    GIVEN("A line that has only been partially received") {
+        atlink::Utils::ParseProgress progress{};
+        int rssi = 0;
+        int ber = 0;
+
+        atlink::Utils::Deserializer partial{"+CSQ: 21,9", progress};
+        REQUIRE(partial.visit(tag));
+        REQUIRE(partial.visit(rssi));
+        REQUIRE(partial.visit(comma));
+        REQUIRE(partial.visit(ber));
+
+        THEN("Only the visits that cannot change are recorded") {
+            REQUIRE(21 == rssi);
+            REQUIRE(3U == progress.size());
+        }
+
+        WHEN("The rest of the line arrives") {
+            atlink::Utils::Deserializer complete{"+CSQ: 21,99\r\n", progress};
+            rssi = 0;
+
+            THEN("Recorded visits are replayed and parsing continues after them") {
+                REQUIRE(complete.visit(tag));
+                REQUIRE(complete.visit(rssi));
+                REQUIRE(complete.visit(comma));
+                REQUIRE(0 == rssi);
+                REQUIRE(9U == complete.consumed());
+                REQUIRE(complete.visit(ber));
+                REQUIRE(99 == ber);
+                REQUIRE_FALSE(complete.exhausted());
+            }
+        }
+    }
+
+    GIVEN("A visitor that is rewound to try another packet") {
+        atlink::Utils::ParseProgress progress{};
+        int rssi = 0;
+
+        atlink::Utils::Deserializer deserializer{"+CSQ: 21,9", progress};
+        REQUIRE(deserializer.visit(tag));
+        REQUIRE(deserializer.visit(rssi));
+        deserializer.rewind();
+
+        THEN("The progress is dropped and no longer recorded") {
+            REQUIRE(0U == progress.size());
+            rssi = 0;
+            REQUIRE(deserializer.visit(tag));
+            REQUIRE(deserializer.visit(rssi));
+            REQUIRE(21 == rssi);
+            REQUIRE(0U == progress.size());
+        }
+    }
+
+    GIVEN("A visit that fails because the line is not complete yet") {
+        atlink::Utils::Deserializer deserializer{"+CS"};
+        WHEN("Deserialized") {
+            auto success = deserializer.visit(tag);
+            THEN("The input is reported as exhausted") {
+                REQUIRE_FALSE(success);
+                REQUIRE(deserializer.exhausted());
+            }
+        }
+    }
+
+    GIVEN("A visit that fails on a complete line") {
+        atlink::Utils::Deserializer deserializer{"+CREG: 1\r\n"};
+        WHEN("Deserialized") {
+            auto success = deserializer.visit(tag);
+            THEN("The input is not reported as exhausted") {
+                REQUIRE_FALSE(success);
+                REQUIRE_FALSE(deserializer.exhausted());
+            }
+        }
+    }
+}
@@ -134,16 +134,87 @@ SCENARIO("Enum to custom string converter works") {
     }
 }
 
-SCENARIO("Enum can be mapped to numbers represented as string") {
+SCENARIO("Custom string converter matches the longest key") {
 
-    enum class TestEnum {
-        VALUE_1 = 130,
-        VALUE_2,
-        VALUE_3,
-        VALUE_4,
-        VALUE_5,
+    enum class Pin { SimPin = 10, SimPin2 = -3, SimPuk = 42 };
+
+    using Record = atlink::Utils::EnumCustomStringRecord<Pin>;
+    static constexpr std::array map = {
+        Record{"SIM_PIN", Pin::SimPin},
+        Record{"SIM_PIN2", Pin::SimPin2},
+        Record{"SIM_PUK", Pin::SimPuk},
     };
 
+    constexpr auto converter = atlink::Utils::EnumCustomStringConverter{map};
+
+    GIVEN("A key that is a prefix of another key") {
+        auto [input, expected, length] =
+            GENERATE(std::make_tuple(std::string_view{"SIM_PIN\r\n"}, Pin::SimPin, 7U),
+                     std::make_tuple(std::string_view{"SIM_PIN2\r\n"}, Pin::SimPin2, 8U),
+                     std::make_tuple(std::string_view{"SIM_PUK,1"}, Pin::SimPuk, 7U));
+
+        WHEN("Converted to enum") {
+            auto variant = Pin{};
+            auto nbytes = converter.parse(variant, input);
+
+            THEN("The longest matching key wins") {
+                REQUIRE(expected == variant);
+                REQUIRE(length == nbytes);
+            }
+        }
+    }
+
+    GIVEN("An input that ends inside a key") {
+        WHEN("Converted to enum") {
+            auto variant = Pin::SimPuk;
+            auto nbytes = converter.parse(variant, "SIM_P");
+
+            THEN("Nothing is matched") {
+                REQUIRE(0U == nbytes);
+                REQUIRE(Pin::SimPuk == variant);
+            }
+        }
+    }
+
+    GIVEN("Enum values that cannot index a table") {
+        WHEN("Converted to string") {
+            std::array<char, 16U> buf{};
+            auto nbytes = converter.stringify(Pin::SimPin2, buf);
+
+            THEN("The string is found by value") {
+                REQUIRE(std::string_view{"SIM_PIN2"} == std::string_view{buf.data(), nbytes});
+            }
+        }
+    }
+}
+
+namespace {
+
+enum class NumericEnum {
+    VALUE_1 = 130,
+    VALUE_2,
+    VALUE_3,
+    VALUE_4,
+    VALUE_5,
+};
+
+} // namespace
+
+template <>
+struct magic_enum::customize::enum_range<NumericEnum> {
+    static constexpr int min = 0;
+    static constexpr int max = 255;
+};
+
+SCENARIO("Enum can be mapped to numbers represented as string") {
+
+    using TestEnum = NumericEnum;
+
+    static_assert(atlink::Utils::EnumStringConverter<TestEnum>::isValid(130), "first value");
+    static_assert(atlink::Utils::EnumStringConverter<TestEnum>::isValid(134), "last value");
+    static_assert(!atlink::Utils::EnumStringConverter<TestEnum>::isValid(129), "below the values");
+    static_assert(!atlink::Utils::EnumStringConverter<TestEnum>::isValid(135), "above the values");
+
     static std::map<std::string_view, TestEnum> map = {
         {"130", TestEnum::VALUE_1},
         {"131", TestEnum::VALUE_2},
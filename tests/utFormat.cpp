@@ -0,0 +1,205 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/core/Format.h"
+#include "atlink/utils/Deserializer.h"
+#include "atlink/utils/Serializer.h"
+
+#include <catch2/catch_all.hpp>
+#include <string>
+
+namespace {
+
+ATL_RESPONSE(CsqResponse, "+CSQ: %d,%d", rssi, ber);
+ATL_RESPONSE(CopsResponse, "+COPS: %d,%d,%16s", mode, format, oper);
+ATL_RESPONSE(CregResponse, "+CREG: %d,%d,\"%x\",\"%x\"", n, stat, lac, ci);
+ATL_RESPONSE(GpsResponse, "+GPS: %.4f,%.4f,%f,%ld,%u", lat, lon, alt, bytes, sats);
+ATL_COMMAND(CsqCommand, "AT+CSQ");
+ATL_COMMAND(CpinCommand, "AT+CPIN=%s", pin);
+ATL_COMMAND(WireCommand, "ATS3=%dS4=%d", s3, s4);
+ATL_COMMAND(FixCommand, "AT+FIX=%.2f,%4x", value, mask);
+
+static_assert(CsqResponse::layout.size() == 2U, "two fields expected");
+static_assert(CsqResponse::layout.tag == "+CSQ:", "trailing whitespace is trimmed");
+static_assert(CsqResponse::layout.fields[0].suffix == ",", "separator follows the field");
+static_assert(CsqResponse::layout.fields[1].suffix.empty(), "no literal after the last field");
+static_assert(std::is_same<decltype(CopsResponse::oper), ATL_NS::Core::QuotedField<16U>>::value,
+              "string width sets the field capacity");
+static_assert(CsqCommand::layout.size() == 0U, "no fields expected");
+static_assert(CregResponse::layout.fields[1].suffix == ",\"", "quotes are part of the literals");
+static_assert(std::is_same<decltype(GpsResponse::bytes), int64_t>::value, "%ld is 64 bits wide");
+static_assert(ATL_NS::Core::Format::parse<1U>("AT+X=%.18f").valid, "18 decimals fit");
+static_assert(!ATL_NS::Core::Format::parse<1U>("AT+X=%.19f").valid, "19 decimals do not");
+static_assert(GpsResponse::layout.fields[0].spec == ATL_NS::Core::Format::Spec::Fixed,
+              "precision selects fixed-point");
+
+} // namespace
+
+SCENARIO("Response declared from a format string can be parsed") {
+
+    GIVEN("A response with two integer fields") {
+        auto res = CsqResponse{};
+
+        WHEN("A valid line is visited") {
+            atlink::Utils::Deserializer deserializer{"\r\n+CSQ: 21,99\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("Both fields are parsed and the whole line is consumed") {
+                REQUIRE(success);
+                REQUIRE(21 == res.rssi);
+                REQUIRE(99 == res.ber);
+                REQUIRE(15U == deserializer.consumed());
+            }
+        }
+
+        WHEN("The space after the tag is missing") {
+            atlink::Utils::Deserializer deserializer{"+CSQ:5,0\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The line is still accepted") {
+                REQUIRE(success);
+                REQUIRE(5 == res.rssi);
+                REQUIRE(0 == res.ber);
+            }
+        }
+
+        WHEN("A line with a different tag is visited") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 0,1\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The response is rejected") {
+                REQUIRE_FALSE(success);
+            }
+        }
+    }
+
+    GIVEN("A response with a string field") {
+        auto res = CopsResponse{};
+
+        WHEN("A valid line is visited") {
+            atlink::Utils::Deserializer deserializer{"+COPS: 0,0,\"Operator\"\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The string is copied into the field") {
+                REQUIRE(success);
+                REQUIRE(0 == res.mode);
+                REQUIRE(std::string_view{"Operator"} == res.oper.view());
+            }
+        }
+    }
+}
+
+SCENARIO("Response declared from a format string parses numeric fields") {
+
+    GIVEN("A response with quoted hex fields") {
+        auto res = CregResponse{};
+        WHEN("A valid line is visited") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 2,1,\"1A2B\",\"01C4D5E6\"\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The hex digits are converted to integers") {
+                REQUIRE(success);
+                REQUIRE(0x1A2BU == res.lac.value);
+                REQUIRE(0x01C4D5E6U == res.ci.value);
+            }
+        }
+    }
+
+    GIVEN("A response with decimal, 64-bit and unsigned fields") {
+        auto res = GpsResponse{};
+        WHEN("A valid line is visited") {
+            atlink::Utils::Deserializer deserializer{
+                "+GPS: 52.52051,-13.4,34.5,8589934592,12\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("Every field holds its binary value") {
+                REQUIRE(success);
+                REQUIRE(525205 == res.lat.raw);
+                REQUIRE(-134000 == res.lon.raw);
+                REQUIRE(34.5 == res.alt);
+                REQUIRE(8589934592LL == res.bytes);
+                REQUIRE(12U == res.sats);
+            }
+        }
+    }
+}
+
+SCENARIO("Command declared from a format string can be serialized") {
+
+    GIVEN("A command without fields") {
+        auto cmd = CsqCommand{};
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("Only the tag and the terminator are written") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+CSQ\r"} == buf);
+            }
+        }
+    }
+
+    GIVEN("A command with a string field") {
+        auto cmd = CpinCommand{};
+        cmd.pin.stream() << "1234";
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("The string is quoted") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+CPIN=\"1234\"\r"} == buf);
+            }
+        }
+    }
+
+    GIVEN("A command with literals between the fields") {
+        auto cmd = WireCommand{};
+        cmd.s3 = 13;
+        cmd.s4 = 10;
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("The literals are emitted instead of commas") {
+                REQUIRE(success);
+                REQUIRE(std::string{"ATS3=13S4=10\r"} == buf);
+            }
+        }
+    }
+
+    GIVEN("A command with fixed-point and hex fields") {
+        auto cmd = FixCommand{};
+        cmd.value.raw = -1205;
+        cmd.mask.value = 0xBEU;
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("Decimals and hex digits are padded") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+FIX=-12.05,00BE\r"} == buf);
+            }
+        }
+    }
+
+    GIVEN("A fixed-point value with more decimals than int64_t can scale") {
+        const ATL_NS::Core::FixedPoint value{1, 20U};
+        WHEN("Serialized") {
+            char buf[64U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = serializer.visit(value);
+            THEN("Serialization fails") {
+                REQUIRE_FALSE(success);
+            }
+        }
+    }
+}
@@ -0,0 +1,253 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/core/List.h"
+#include "atlink/core/Response.h"
+#include "atlink/utils/Deserializer.h"
+
+#include <catch2/catch_all.hpp>
+#include <string>
+
+namespace {
+
+using ATL_NS::Core::List;
+using ATL_NS::Core::RangeField;
+
+class CnmiTestResponse : public ATL_NS::Core::Response {
+  public:
+    RangeField<2U> mode{};
+    RangeField<4U> mt{};
+    RangeField<4U> bm{};
+    RangeField<4U> ds{};
+    RangeField<4U> bfr{};
+
+    CnmiTestResponse() : ATL_NS::Core::Response("+CNMI:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return Response::acceptImpl(visitor, mode, mt, bm, ds, bfr);
+    }
+};
+
+class RangeLinesResponse : public ATL_NS::Core::MultiLineResponse {
+  public:
+    class Line : public ATL_NS::Core::Line {
+      public:
+        RangeField<2U> ranges{};
+
+        bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+            return ATL_NS::Core::Line::acceptImpl(visitor, ranges);
+        }
+    };
+
+    Line line1{};
+    Line line2{};
+
+    RangeLinesResponse() : ATL_NS::Core::MultiLineResponse("+TEST:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return ATL_NS::Core::MultiLineResponse::acceptImpl(visitor, line1, line2);
+    }
+};
+
+class Operator : public ATL_NS::Core::ListItem {
+  public:
+    int stat{};
+    ATL_NS::Core::QuotedField<24U> longName{};
+    ATL_NS::Core::QuotedField<12U> shortName{};
+    ATL_NS::Core::QuotedField<8U> numeric{};
+    int act{};
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return ListItem::acceptImpl(visitor, stat, longName, shortName, numeric, act);
+    }
+};
+
+template <std::size_t N>
+class CopsTestResponse : public ATL_NS::Core::Response {
+  public:
+    List<Operator, N> operators{};
+
+    CopsTestResponse() : ATL_NS::Core::Response("+COPS:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return Response::acceptImpl(visitor, operators);
+    }
+};
+
+class OperatorLinesResponse : public ATL_NS::Core::MultiLineResponse {
+  public:
+    class Line : public ATL_NS::Core::Line {
+      public:
+        List<Operator, 0U> operators{};
+
+        bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+            return ATL_NS::Core::Line::acceptImpl(visitor, operators);
+        }
+    };
+
+    Line line1{};
+    Line line2{};
+
+    OperatorLinesResponse() : ATL_NS::Core::MultiLineResponse("+TEST:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return ATL_NS::Core::MultiLineResponse::acceptImpl(visitor, line1, line2);
+    }
+};
+
+void countOperator(const Operator &op, void *ctx) {
+    *static_cast<int *>(ctx) += op.act;
+}
+
+} // namespace
+
+SCENARIO("Range fields of a test response can be parsed") {
+
+    GIVEN("A test response with value lists and ranges") {
+        auto res = CnmiTestResponse{};
+
+        WHEN("Deserialized") {
+            atlink::Utils::Deserializer deserializer{
+                "+CNMI: (0-2),(0-3),(0,2),(0,1,3-5),(0,1)\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("Each group holds its values and ranges") {
+                REQUIRE(success);
+                REQUIRE(1U == res.mode.size());
+                REQUIRE(0 == res.mode[0].first);
+                REQUIRE(2 == res.mode[0].last);
+                REQUIRE(2U == res.bm.size());
+                REQUIRE_FALSE(res.bm.contains(1));
+                REQUIRE(3U == res.ds.size());
+                REQUIRE(res.ds.contains(4));
+                REQUIRE_FALSE(res.ds.truncated());
+            }
+        }
+
+        WHEN("A group has more entries than the field can hold") {
+            atlink::Utils::Deserializer deserializer{
+                "+CNMI: (0,1,2),(0-3),(0,2),(0,1),(0,1)\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The surplus entries are dropped and reported") {
+                REQUIRE(success);
+                REQUIRE(2U == res.mode.size());
+                REQUIRE(res.mode.truncated());
+            }
+        }
+    }
+}
+
+SCENARIO("Range fields keep their values when a response arrives in chunks") {
+
+    GIVEN("A multi-line response with one range field per line") {
+        auto res = RangeLinesResponse{};
+        atlink::Utils::ParseProgress progress{};
+
+        WHEN("The first line is complete and the second one is not") {
+            atlink::Utils::Deserializer partial{"\r\n+TEST:\r\n(0-2,5)\r\n(1", progress};
+            REQUIRE_FALSE(res.accept(partial));
+
+            atlink::Utils::Deserializer complete{"\r\n+TEST:\r\n(0-2,5)\r\n(1-4)\r\n",
+                                                 progress};
+            auto success = res.accept(complete);
+            THEN("Ranges replayed from the first attempt are kept") {
+                REQUIRE(success);
+                REQUIRE(2U == res.line1.ranges.size());
+                REQUIRE(0 == res.line1.ranges[0].first);
+                REQUIRE(2 == res.line1.ranges[0].last);
+                REQUIRE(5 == res.line1.ranges[1].last);
+                REQUIRE(1 == res.line2.ranges[0].first);
+                REQUIRE(4 == res.line2.ranges[0].last);
+            }
+        }
+    }
+}
+
+SCENARIO("List fields can be parsed") {
+
+    const char *input = "+COPS: (2,\"Operator A\",\"OpA\",\"26201\",7),"
+                        "(1,\"Operator B\",\"OpB\",\"26202\",2)\r\n";
+
+    GIVEN("A list with room for every item") {
+        auto res = CopsTestResponse<4U>{};
+
+        WHEN("Deserialized") {
+            atlink::Utils::Deserializer deserializer{input};
+            auto success = res.accept(deserializer);
+            THEN("All items are stored in order") {
+                REQUIRE(success);
+                REQUIRE(2U == res.operators.size());
+                REQUIRE(2 == res.operators[0].stat);
+                REQUIRE(std::string_view{"OpA"} == res.operators[0].shortName.view());
+                REQUIRE(std::string_view{"26202"} == res.operators[1].numeric.view());
+                REQUIRE(2 == res.operators[1].act);
+                REQUIRE_FALSE(res.operators.truncated());
+            }
+        }
+    }
+
+    GIVEN("A list without storage but with a sink") {
+        auto res = CopsTestResponse<0U>{};
+        int sum = 0;
+        res.operators.setSink(countOperator, &sum);
+
+        WHEN("Deserialized") {
+            atlink::Utils::Deserializer deserializer{input};
+            auto success = res.accept(deserializer);
+            THEN("Every item is passed to the sink") {
+                REQUIRE(success);
+                REQUIRE(9 == sum);
+                REQUIRE(0U == res.operators.size());
+                REQUIRE(2U == res.operators.droppedCount());
+            }
+        }
+    }
+
+    GIVEN("A list with a sink in a response that arrives in chunks") {
+        auto res = OperatorLinesResponse{};
+        int sum = 0;
+        res.line1.operators.setSink(countOperator, &sum);
+        atlink::Utils::ParseProgress progress{};
+
+        WHEN("The line holding the list is parsed on both attempts") {
+            const char *line1 = "(2,\"A\",\"A\",\"1\",7),(1,\"B\",\"B\",\"2\",2)\r\n";
+            const std::string partial = std::string{"\r\n+TEST:\r\n"} + line1 + "(0";
+            atlink::Utils::Deserializer first{partial, progress};
+            REQUIRE_FALSE(res.accept(first));
+
+            const std::string complete =
+                std::string{"\r\n+TEST:\r\n"} + line1 + "(0,\"C\",\"C\",\"3\",0)\r\n";
+            atlink::Utils::Deserializer second{complete, progress};
+            auto success = res.accept(second);
+            THEN("The sink sees the actual items every time") {
+                REQUIRE(success);
+                REQUIRE(18 == sum);
+            }
+        }
+    }
+
+    GIVEN("An item that is not closed") {
+        auto res = CopsTestResponse<4U>{};
+
+        WHEN("Deserialized") {
+            atlink::Utils::Deserializer deserializer{"+COPS: (2,\"A\",\"B\",\"1\",7\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The response is rejected") {
+                REQUIRE_FALSE(success);
+            }
+        }
+    }
+}
@@ -0,0 +1,246 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// The Orchestrator runs on a platform whose DeviceIO is fed by the test.
+#define AT_PLATFORM_TAG ::fake::Platform
+
+#include "atlink/platform/Registry.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/span>
+#include <string>
+#include <string_view>
+
+namespace fake {
+
+struct Platform {};
+
+using Subscriber = ATL_NS::Platform::Api::Subscriber;
+
+// The DeviceIO facade owns its backend, so the test reaches the fake
+// through this.
+struct Wire {
+    std::string rx{};
+    std::size_t reads{0U};
+    // RxReady announcements the next read() makes from the FSM thread, as
+    // the epoll and io_uring backends do while more input is pending.
+    int wakeups{0};
+    Subscriber *subscriber{nullptr};
+};
+
+inline Wire wire{};
+
+class DeviceIO {
+  public:
+    DeviceIO() = default;
+    explicit DeviceIO(const ATL_NS::Platform::Api::SerialConfig &) {}
+
+    void subscribe(Subscriber &s) {
+        wire.subscriber = &s;
+    }
+
+    size_t write(std::string_view s) {
+        return s.size();
+    }
+
+    size_t write(gsl::span<const std::string_view> chunks) {
+        size_t n = 0U;
+        for (const auto &chunk : chunks) {
+            n += chunk.size();
+        }
+        return n;
+    }
+
+    size_t read(gsl::span<char> buf) {
+        ++wire.reads;
+        for (; 0 < wire.wakeups; --wire.wakeups) {
+            wire.subscriber->notify(Subscriber::Event::RxReady);
+        }
+        const auto n = std::min(buf.size(), wire.rx.size());
+        std::copy_n(wire.rx.data(), n, buf.data());
+        wire.rx.erase(0U, n);
+        return n;
+    }
+
+    bool setBaudRate(uint32_t) {
+        return true;
+    }
+};
+
+} // namespace fake
+
+namespace ATL_NS {
+namespace Platform {
+
+template <>
+struct Components<::fake::Platform> : Components<Tags::Linux> {
+    using DeviceIOImpl = ::fake::DeviceIO;
+};
+
+} // namespace Platform
+} // namespace ATL_NS
+
+#include "atlink/core/FinalResultCode.h"
+#include "atlink/core/fsm/Orchestrator.h"
+
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+namespace {
+
+using ATL_NS::Core::Fsm::Orchestrator;
+
+class NoUrcs : public ATL_NS::Core::AUrcDispatcher {
+  public:
+    size_t dispatch(ATL_NS::Core::ReadOnlyText) override {
+        return 0U;
+    }
+};
+
+class CsqResponse : public ATL_NS::Core::Response {
+  public:
+    int rssi{};
+    int ber{};
+
+    CsqResponse() : ATL_NS::Core::Response("+CSQ:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return Response::acceptImpl(visitor, rssi, ber);
+    }
+};
+
+class TwoLineResponse : public ATL_NS::Core::MultiLineResponse {
+  public:
+    class Line : public ATL_NS::Core::Line {
+      public:
+        std::array<char, 16U> storage{};
+        ATL_NS::Core::LineText content{storage};
+
+        bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+            return ATL_NS::Core::Line::acceptImpl(visitor, content);
+        }
+    };
+
+    Line line1{};
+    Line line2{};
+
+    TwoLineResponse() : ATL_NS::Core::MultiLineResponse("+TEST:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return ATL_NS::Core::MultiLineResponse::acceptImpl(visitor, line1, line2);
+    }
+};
+
+void collectLine(ATL_NS::Core::ReadOnlyText line, void *ctx) {
+    static_cast<std::vector<std::string> *>(ctx)->emplace_back(line);
+}
+
+} // namespace
+
+SCENARIO("Readiness events never fill the event queue") {
+
+    GIVEN("An orchestrator whose events are not taken yet") {
+        fake::wire = fake::Wire{};
+        ATL_NS::Platform::DeviceIO io{};
+        NoUrcs urcs{};
+        Orchestrator orchestrator{io, urcs};
+
+        WHEN("Far more events are posted than the queue holds") {
+            for (int i = 0; i < 1000; ++i) {
+                orchestrator.notify(fake::Subscriber::Event::RxReady);
+                Orchestrator::timerCallback(&orchestrator);
+            }
+            fake::wire.wakeups = 1000;
+            orchestrator.shutDown();
+            orchestrator.loop();
+
+            THEN("They are coalesced, also when posted from the FSM thread") {
+                REQUIRE(1U == fake::wire.reads);
+                REQUIRE(0 == fake::wire.wakeups);
+            }
+        }
+    }
+}
+
+SCENARIO("Input nothing can parse is dropped a line at a time") {
+
+    GIVEN("An orchestrator waiting for a response") {
+        fake::wire = fake::Wire{};
+        ATL_NS::Platform::DeviceIO io{};
+        NoUrcs urcs{};
+        Orchestrator orchestrator{io, urcs};
+        std::vector<std::string> dropped{};
+        orchestrator.setRawLineHook(collectLine, &dropped);
+        ATL_NS::Core::FinalResultCode<> frc{};
+
+        WHEN("A garbage line precedes the response") {
+            CsqResponse csq{};
+            fake::wire.rx = "\r\nGARBAGE\r\n\r\n+CSQ: 21,99\r\n\r\nOK\r\n";
+            auto success = orchestrator.receive(frc, &csq);
+
+            THEN("It is skipped and the response behind it still parses") {
+                REQUIRE(success);
+                REQUIRE(21 == csq.rssi);
+                REQUIRE(99 == csq.ber);
+                REQUIRE(frc.holds<ATL_NS::Proto::Std::Ok>());
+            }
+
+            AND_THEN("The line is counted and handed to the hook") {
+                const auto stats = orchestrator.statistics();
+                REQUIRE(1U == stats.resyncs);
+                REQUIRE(0U == stats.overflows);
+                REQUIRE(9U == stats.droppedBytes);
+                REQUIRE(std::vector<std::string>{"GARBAGE\r\n"} == dropped);
+            }
+        }
+
+        WHEN("The buffer fills up without a line end") {
+            fake::wire.rx = std::string(600U, 'x');
+            REQUIRE_FALSE(orchestrator.receive(frc, nullptr));
+            REQUIRE_FALSE(orchestrator.receive(frc, nullptr));
+
+            THEN("The whole buffer is dropped as an overflow") {
+                const auto stats = orchestrator.statistics();
+                REQUIRE(0U == stats.resyncs);
+                REQUIRE(1U == stats.overflows);
+                REQUIRE(512U == stats.droppedBytes);
+                REQUIRE(1U == dropped.size());
+                REQUIRE(std::string(512U, 'x') == dropped[0]);
+            }
+        }
+
+        WHEN("Only the first lines of a response have arrived") {
+            TwoLineResponse res{};
+            fake::wire.rx = "\r\n+TEST:\r\nline one\r\n";
+            REQUIRE_FALSE(orchestrator.receive(frc, &res));
+            fake::wire.rx = "line two\r\n\r\nOK\r\n";
+            auto success = orchestrator.receive(frc, &res);
+
+            THEN("They are kept until the rest completes the response") {
+                REQUIRE(success);
+                auto line1 = std::string_view{res.line1.content.buf.data()};
+                REQUIRE(std::string_view{"line one"} == line1);
+                auto line2 = std::string_view{res.line2.content.buf.data()};
+                REQUIRE(std::string_view{"line two"} == line2);
+                REQUIRE(0U == orchestrator.statistics().resyncs);
+                REQUIRE(dropped.empty());
+            }
+        }
+    }
+}
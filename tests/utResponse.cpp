@@ -40,6 +40,21 @@ class TestResponse : public ATL_NS::Core::Response {
     }
 };
 
+class CregResponse : public ATL_NS::Core::Response {
+  public:
+    int n{};
+    int stat{};
+    ATL_NS::Core::Optional<ATL_NS::Core::Hex> lac{};
+    ATL_NS::Core::Optional<ATL_NS::Core::Hex> ci{};
+    ATL_NS::Core::Optional<int> act{};
+
+    CregResponse() : ATL_NS::Core::Response("+CREG:") {}
+
+    bool accept(ATL_NS::Core::AResponseVisitor &visitor) override {
+        return Response::acceptImpl(visitor, n, stat, lac, ci, act);
+    }
+};
+
 } // namespace
 
 template <>
@@ -137,4 +152,57 @@ SCENARIO("Response can accept visitor") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Response with optional fields matches every shape of a line") {
+
+    GIVEN("A response whose last three fields are optional") {
+        auto res = CregResponse{};
+
+        WHEN("All fields are present") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 2,1,\"1A2B\",\"01C4D5E6\",7\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("Every field is parsed and marked present") {
+                REQUIRE(success);
+                REQUIRE(res.lac);
+                REQUIRE(0x1A2BU == res.lac.value.value);
+                REQUIRE(res.ci);
+                REQUIRE(res.act);
+                REQUIRE(7 == res.act.value);
+            }
+        }
+
+        WHEN("The optional fields are omitted") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 0,1\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The line is accepted and the optional fields are absent") {
+                REQUIRE(success);
+                REQUIRE(1 == res.stat);
+                REQUIRE_FALSE(res.lac);
+                REQUIRE_FALSE(res.ci);
+                REQUIRE_FALSE(res.act);
+                REQUIRE(12U == deserializer.consumed());
+            }
+        }
+
+        WHEN("An optional field in the middle is empty") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 2,1,,\"01C4D5E6\"\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("Only the empty field is absent") {
+                REQUIRE(success);
+                REQUIRE_FALSE(res.lac);
+                REQUIRE(res.ci);
+                REQUIRE(0x01C4D5E6U == res.ci.value.value);
+                REQUIRE_FALSE(res.act);
+            }
+        }
+
+        WHEN("A mandatory field is missing") {
+            atlink::Utils::Deserializer deserializer{"+CREG: 2\r\n"};
+            auto success = res.accept(deserializer);
+            THEN("The line is rejected") {
+                REQUIRE_FALSE(success);
+            }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/core/FinalResultCode.h"
+#include "atlink/core/ResponseArena.h"
+#include "atlink/utils/Deserializer.h"
+
+#include <catch2/catch_all.hpp>
+
+namespace {
+
+using ATL_NS::Core::AResponseVisitor;
+using ATL_NS::Core::Response;
+
+class BigResponse : public Response {
+  public:
+    std::array<char, 200U> storage;
+    ATL_NS::Core::LineText text{storage};
+
+    BigResponse() : Response("+BIG:") {}
+
+    bool accept(AResponseVisitor &v) override {
+        return Response::acceptImpl(v, text);
+    }
+};
+
+class SmallResponse : public Response {
+  public:
+    int value{0};
+
+    SmallResponse() : Response("+SMALL:") {}
+
+    bool accept(AResponseVisitor &v) override {
+        return Response::acceptImpl(v, value);
+    }
+};
+
+using Arena = ATL_NS::Core::ResponseArena<256U, 2U>;
+
+} // namespace
+
+SCENARIO("Response arena hands out a fixed number of slots") {
+
+    GIVEN("An arena with two slots") {
+        Arena arena{};
+
+        WHEN("Both slots are taken") {
+            void *a = arena.acquire(16U, 8U);
+            void *b = arena.acquire(256U, 8U);
+
+            THEN("They are distinct and no third one is available") {
+                REQUIRE(nullptr != a);
+                REQUIRE(nullptr != b);
+                REQUIRE(a != b);
+                REQUIRE(nullptr == arena.acquire(16U, 8U));
+                REQUIRE(0U == arena.available());
+            }
+
+            AND_WHEN("One is released") {
+                arena.release(a);
+                THEN("It can be acquired again") {
+                    REQUIRE(a == arena.acquire(16U, 8U));
+                }
+            }
+        }
+
+        WHEN("More than a slot is requested") {
+            THEN("The request is refused") {
+                REQUIRE(nullptr == arena.acquire(257U, 8U));
+                REQUIRE(2U == arena.available());
+            }
+        }
+    }
+}
+
+SCENARIO("ArenaPack keeps only the matching alternative") {
+
+    GIVEN("A pack of a large and a small response backed by an arena") {
+        Arena arena{};
+        ATL_NS::Core::ArenaPack<BigResponse, SmallResponse> pack{arena};
+
+        WHEN("A line matching the small response is parsed") {
+            atlink::Utils::Deserializer d{"+SMALL: 7\r\n"};
+            const bool ok = pack.accept(d);
+
+            THEN("The small response is held in one slot") {
+                REQUIRE(ok);
+                REQUIRE(pack.holds<SmallResponse>());
+                REQUIRE(7 == pack.getIf<SmallResponse>()->value);
+                REQUIRE(nullptr == pack.getIf<BigResponse>());
+                REQUIRE(1U == arena.available());
+            }
+
+            AND_WHEN("The response is taken and dropped") {
+                {
+                    auto handle = pack.take();
+                    REQUIRE(handle);
+                    REQUIRE_FALSE(pack.holds<SmallResponse>());
+                }
+                THEN("The slot is back in the arena") {
+                    REQUIRE(2U == arena.available());
+                }
+            }
+        }
+
+        WHEN("A line matching no alternative is parsed") {
+            atlink::Utils::Deserializer d{"OK\r\n"};
+            const bool ok = pack.accept(d);
+
+            THEN("No slot stays in use") {
+                REQUIRE_FALSE(ok);
+                REQUIRE(2U == arena.available());
+            }
+        }
+    }
+
+    GIVEN("The final result codes backed by an arena") {
+        Arena arena{};
+        ATL_NS::Core::ArenaPack<ATL_NS::Proto::Std::Ok, ATL_NS::Proto::Std::Error> pack{arena};
+
+        WHEN("OK is parsed") {
+            atlink::Utils::Deserializer d{"\r\nOK\r\n"};
+            THEN("The result is available") {
+                REQUIRE(pack.accept(d));
+                REQUIRE(pack.holds<ATL_NS::Proto::Std::Ok>());
+            }
+        }
+    }
+}
+
+SCENARIO("ArenaResponse takes a slot only when a line is parsed for it") {
+
+    GIVEN("An arena backed response") {
+        Arena arena{};
+        ATL_NS::Core::ArenaResponse<BigResponse> res{arena};
+
+        THEN("Nothing is allocated up front") {
+            REQUIRE(nullptr == res.get());
+            REQUIRE(2U == arena.available());
+        }
+
+        WHEN("A matching line is parsed") {
+            atlink::Utils::Deserializer d{"+BIG:payload\r\n"};
+            const bool ok = res.accept(d);
+
+            THEN("The response lives in a slot until it is reset") {
+                REQUIRE(ok);
+                REQUIRE(std::string_view{"payload"} == res.get()->storage.data());
+                REQUIRE(1U == arena.available());
+                res.reset();
+                REQUIRE(2U == arena.available());
+            }
+        }
+
+        WHEN("The command is answered by a plain OK") {
+            atlink::Utils::Deserializer d{"\r\nOK\r\n"};
+            const bool ok = res.accept(d);
+
+            THEN("No slot is kept") {
+                REQUIRE_FALSE(ok);
+                REQUIRE(nullptr == res.get());
+                REQUIRE(2U == arena.available());
+            }
+        }
+
+        WHEN("Only the start of the line has arrived") {
+            atlink::Utils::Deserializer d{"+BIG:pay"};
+            const bool ok = res.accept(d);
+
+            THEN("The slot is kept for the next attempt") {
+                REQUIRE_FALSE(ok);
+                REQUIRE(nullptr != res.get());
+                REQUIRE(1U == arena.available());
+            }
+        }
+    }
+}
@@ -16,7 +16,9 @@
 //  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
 //
 
+#include "atlink/core/FinalResultCode.h"
 #include "atlink/core/ResponsePack.h"
+#include "atlink/core/Urc.h"
 #include "atlink/utils/Deserializer.h"
 
 #include <catch2/catch_all.hpp>
@@ -80,6 +82,46 @@ class DupIntStr : public Response {
     }
 };
 
+// The same responses announcing their tags for the single-candidate path.
+class TaggedFoo : public FooResponse {
+  public:
+    static constexpr ATL_NS::Core::ReadOnlyText Tag{"+FOO:"};
+};
+
+class TaggedBar : public BarResponse {
+  public:
+    static constexpr ATL_NS::Core::ReadOnlyText Tag{"+BAR:"};
+};
+
+class TaggedDupIntOnly : public DupIntOnly {
+  public:
+    static constexpr ATL_NS::Core::ReadOnlyText Tag{"+DUP:"};
+};
+
+class TaggedDupIntStr : public DupIntStr {
+  public:
+    static constexpr ATL_NS::Core::ReadOnlyText Tag{"+DUP:"};
+};
+
+using ATL_NS::Core::ResponsePack;
+using ATL_NS::Core::TagSet;
+using Text = ATL_NS::Core::ReadOnlyText;
+
+static_assert(ResponsePack<TaggedFoo, TaggedBar>::singleCandidate, "distinct tags");
+static_assert(!ResponsePack<FooResponse, BarResponse>::singleCandidate, "tags are not declared");
+static_assert(!ResponsePack<TaggedDupIntOnly, TaggedDupIntStr>::singleCandidate, "same tag");
+static_assert(ATL_NS::Core::Urc<TaggedFoo, TaggedBar>::singleCandidate,
+              "the catch-all is untagged");
+static_assert(ATL_NS::Core::FinalResultCode<TaggedBar>::singleCandidate,
+              "result codes are untagged");
+static_assert(!TagSet<2U>{{Text{"+C"}, Text{"+CSQ:"}}}.prefixFree(), "+C is a prefix of +CSQ:");
+static_assert(TagSet<3U>{{Text{"+CSQ:"}, Text{"+CSQN:"}, Text{"+CS:"}}}.prefixFree(),
+              "no tag starts with another");
+static_assert(TagSet<3U>{{Text{"+CSQ:"}, Text{"+CSQN:"}, Text{"+CS:"}}}.find("+CSQN: 1") == 1U,
+              "the tag the input starts with is found");
+static_assert(TagSet<2U>{{Text{"+CSQ:"}, Text{"+CSQN:"}}}.find("+CSR: 1") == 2U,
+              "npos if no tag matches");
+
 } // namespace
 
 SCENARIO("ResponsePack parses the first matching response type") {
@@ -142,6 +184,19 @@ SCENARIO("ResponsePack parses the first matching response type") {
             }
         }
 
+        WHEN("Input does not match after a successful parse") {
+            atlink::Utils::Deserializer d1{"+BAR: 99\r\n"};
+            REQUIRE(pack.accept(d1));
+
+            atlink::Utils::Deserializer d2{"+BAR: x\r\n"};
+            const bool ok = pack.accept(d2);
+
+            THEN("The partially parsed candidate is discarded") {
+                REQUIRE_FALSE(ok);
+                REQUIRE_FALSE(pack.holds<BarResponse>());
+            }
+        }
+
         WHEN("Reset is called after a successful parse") {
             atlink::Utils::Deserializer d1{"+BAR: 99\r\n"};
             REQUIRE(pack.accept(d1));
@@ -248,6 +303,19 @@ SCENARIO("ResponsePack with a single response type works and accessors behave co
             }
         }
 
+        WHEN("Input does not match after a successful parse") {
+            atlink::Utils::Deserializer d1{"+BAR: 99\r\n"};
+            REQUIRE(pack.accept(d1));
+
+            atlink::Utils::Deserializer d2{"+BAR: x\r\n"};
+            const bool ok = pack.accept(d2);
+
+            THEN("The partially parsed candidate is discarded") {
+                REQUIRE_FALSE(ok);
+                REQUIRE_FALSE(pack.holds<BarResponse>());
+            }
+        }
+
         WHEN("Reset is called after a successful parse") {
             atlink::Utils::Deserializer d1{"+BAR: 99\r\n"};
             REQUIRE(pack.accept(d1));
@@ -269,4 +337,52 @@ SCENARIO("ResponsePack with a single response type works and accessors behave co
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("ResponsePack with prefix-free tags parses a single candidate") {
+
+    GIVEN("A URC set with tagged alternatives and the catch-all") {
+        ATL_NS::Core::Urc<TaggedFoo, TaggedBar> pack{};
+
+        WHEN("The input carries a known tag") {
+            atlink::Utils::Deserializer d{"\r\n+BAR: 4\r\n"};
+            const bool ok = pack.accept(d);
+            THEN("The alternative with that tag is parsed") {
+                REQUIRE(ok);
+                REQUIRE(pack.holds<TaggedBar>());
+                REQUIRE(4 == pack.getIf<TaggedBar>()->value);
+            }
+        }
+
+        WHEN("The input carries an unknown tag") {
+            atlink::Utils::Deserializer d{"+QIND: x\r\n"};
+            const bool ok = pack.accept(d);
+            THEN("The catch-all takes it") {
+                REQUIRE(ok);
+                REQUIRE(pack.holds<ATL_NS::Core::AnyUrc>());
+            }
+        }
+
+        WHEN("The alternative with the tag rejects the line") {
+            atlink::Utils::Deserializer d{"+FOO: x\r\n"};
+            const bool ok = pack.accept(d);
+            THEN("The catch-all still takes it") {
+                REQUIRE(ok);
+                REQUIRE(pack.holds<ATL_NS::Core::AnyUrc>());
+            }
+        }
+    }
+
+    GIVEN("Final result codes with a tagged response") {
+        ATL_NS::Core::FinalResultCode<TaggedBar> frc{};
+
+        WHEN("OK is received") {
+            atlink::Utils::Deserializer d{"\r\nOK\r\n"};
+            const bool ok = frc.accept(d);
+            THEN("The untagged result code is tried") {
+                REQUIRE(ok);
+                REQUIRE(frc.holds<ATL_NS::Proto::Std::Ok>());
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/utils/TimingWheel.h"
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using Wheel = ATL_NS::Utils::TimingWheel<3U>;
+using Node = Wheel::Node;
+
+std::vector<const Node *> drain(Wheel &wheel) {
+    std::vector<const Node *> out;
+    while (auto *node = wheel.popExpired()) {
+        out.push_back(node);
+    }
+    return out;
+}
+
+// Advances one tick at a time and returns the tick at which node expired.
+uint64_t expiryTick(Wheel &wheel, Node &node, uint64_t limit) {
+    while (wheel.now() < limit) {
+        wheel.advance(wheel.now() + 1U);
+        for (const auto *expired : drain(wheel)) {
+            if (expired == &node) {
+                return wheel.now();
+            }
+        }
+    }
+    return Wheel::Never;
+}
+
+} // namespace
+
+SCENARIO("Timing wheel expires nodes at their deadline") {
+
+    GIVEN("Deadlines in every level and beyond the top one") {
+        const uint64_t deadline = GENERATE(as<uint64_t>{}, 1, 63, 64, 65, 4095, 4096, 300000);
+        Wheel wheel{7U};
+        Node node;
+        wheel.insert(node, 7U + deadline);
+
+        WHEN("Time advances tick by tick") {
+            const auto tick = expiryTick(wheel, node, 7U + deadline + 10U);
+            THEN("The node expires exactly on its deadline") {
+                REQUIRE(7U + deadline == tick);
+                REQUIRE(wheel.empty());
+            }
+        }
+
+        WHEN("Time jumps past the deadline") {
+            wheel.advance(7U + deadline + 3U);
+            THEN("The node is expired once") {
+                const auto expired = drain(wheel);
+                REQUIRE(1U == expired.size());
+                REQUIRE(&node == expired[0]);
+                REQUIRE(wheel.empty());
+            }
+        }
+    }
+
+    GIVEN("A deadline that is already due") {
+        Wheel wheel{100U};
+        Node node;
+        wheel.insert(node, 50U);
+        THEN("It expires with the next tick") {
+            REQUIRE(101U == wheel.nextEvent());
+            wheel.advance(101U);
+            REQUIRE(&node == wheel.popExpired());
+        }
+    }
+}
+
+SCENARIO("Timing wheel nodes can be removed and rescheduled") {
+
+    GIVEN("Two nodes in different levels") {
+        Wheel wheel{};
+        Node early;
+        Node late;
+        wheel.insert(early, 10U);
+        wheel.insert(late, 1000U);
+
+        THEN("The next event is the earliest slot to process") {
+            REQUIRE(10U == wheel.nextEvent());
+        }
+
+        WHEN("The early node is removed") {
+            wheel.remove(early);
+            THEN("Only the late one is left") {
+                REQUIRE_FALSE(early.linked());
+                REQUIRE(960U == wheel.nextEvent());
+                wheel.advance(2000U);
+                const auto expired = drain(wheel);
+                REQUIRE(1U == expired.size());
+                REQUIRE(&late == expired[0]);
+            }
+        }
+
+        WHEN("The late node is moved before the early one") {
+            wheel.insert(late, 5U);
+            wheel.advance(5U);
+            THEN("It expires first") {
+                REQUIRE(&late == wheel.popExpired());
+                REQUIRE(nullptr == wheel.popExpired());
+                wheel.advance(10U);
+                REQUIRE(&early == wheel.popExpired());
+            }
+        }
+
+        WHEN("An expired node is removed before it is popped") {
+            wheel.advance(10U);
+            wheel.remove(early);
+            THEN("It is not returned") {
+                REQUIRE(nullptr == wheel.popExpired());
+            }
+        }
+    }
+
+    GIVEN("An empty wheel") {
+        Wheel wheel{};
+        THEN("There is no event") {
+            REQUIRE(Wheel::Never == wheel.nextEvent());
+            wheel.advance(1000000U);
+            REQUIRE(1000000U == wheel.now());
+        }
+    }
+}
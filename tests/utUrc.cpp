@@ -15,6 +15,7 @@
 //  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
 //
 
+#include "atlink/core/LazyUrc.h"
 #include "atlink/core/Urc.h"
 #include "atlink/utils/Deserializer.h"
 
@@ -37,6 +38,37 @@ class FooUrc : public Response {
     }
 };
 
+class TaggedFooUrc : public FooUrc {
+  public:
+    static constexpr ReadOnlyText Tag{"+FOO:"};
+};
+
+class QindUrc : public Response {
+  public:
+    static constexpr ReadOnlyText Tag{"+QIND:"};
+    std::array<char, 32U> storage;
+    LineText text{storage};
+
+    QindUrc() : Response(Tag) {}
+
+    bool accept(AResponseVisitor &visitor) override {
+        return Response::acceptImpl(visitor, text);
+    }
+};
+
+using Lazy = LazyUrcDispatcher<64U, TaggedFooUrc, QindUrc>;
+
+struct Received {
+    Lazy::Record last{};
+    int count{0};
+
+    static void store(const Lazy::Record &urc, void *ctx) {
+        auto *self = static_cast<Received *>(ctx);
+        self->last = urc;
+        ++self->count;
+    }
+};
+
 template <typename UrcPack>
 class TestUrcDispatcher : public AUrcDispatcher {
   public:
@@ -187,4 +219,74 @@ SCENARIO("Dispatcher can be reused for multiple URCs") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Lazy dispatcher hands over raw URCs by tag") {
+
+    GIVEN("A subscriber for +FOO only") {
+        Lazy dispatcher{};
+        Received foo{};
+        dispatcher.subscribe<TaggedFooUrc>(Received::store, &foo);
+
+        WHEN("A +FOO URC is dispatched") {
+            const ReadOnlyText input{"\r\n+FOO: 42\r\n+QIND: x"};
+            const auto before = Lazy::Record::Clock::now();
+            auto consumed = dispatcher.dispatch(input);
+
+            THEN("Its raw line is recorded with tag and time") {
+                REQUIRE(12U == consumed);
+                REQUIRE(1 == foo.count);
+                REQUIRE(Lazy::idOf<TaggedFooUrc>() == foo.last.tag);
+                REQUIRE(std::string_view{"+FOO: 42\r\n"} == foo.last.line());
+                REQUIRE(before <= foo.last.received);
+            }
+
+            AND_THEN("The subscriber decodes it when needed") {
+                TaggedFooUrc urc{};
+                REQUIRE(foo.last.decode(urc));
+                REQUIRE(42 == urc.value);
+            }
+        }
+
+        WHEN("A URC nobody subscribed to is dispatched") {
+            const ReadOnlyText input{"+QIND: \"csq\",5\r\n"};
+            auto consumed = dispatcher.dispatch(input);
+
+            THEN("It is skipped without being recorded") {
+                REQUIRE(input.size() == consumed);
+                REQUIRE(0 == foo.count);
+            }
+        }
+
+        WHEN("A line with an unknown tag is dispatched") {
+            auto consumed = dispatcher.dispatch(ReadOnlyText{"+CGREG: 1\r\n"});
+            THEN("It is left to the caller") {
+                REQUIRE(0U == consumed);
+                REQUIRE(0 == foo.count);
+            }
+        }
+
+        WHEN("A line is incomplete") {
+            auto consumed = dispatcher.dispatch(ReadOnlyText{"+FOO: 4"});
+            THEN("Nothing is consumed") {
+                REQUIRE(0U == consumed);
+                REQUIRE(0 == foo.count);
+            }
+        }
+    }
+
+    GIVEN("A subscriber for unknown tags") {
+        Lazy dispatcher{};
+        Received other{};
+        dispatcher.subscribeUnknown(Received::store, &other);
+
+        WHEN("A line with an unknown tag is dispatched") {
+            auto consumed = dispatcher.dispatch(ReadOnlyText{"+CGREG: 1\r\n"});
+            THEN("It is handed over as unknown") {
+                REQUIRE(11U == consumed);
+                REQUIRE(1 == other.count);
+                REQUIRE(Lazy::unknown == other.last.tag);
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+//
+//  This file is part of ATLink.
+//
+//  ATLink is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ATLink is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ATLink.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "atlink/core/FinalResultCode.h"
+#include "atlink/core/Format.h"
+#include "atlink/protocols/standard/Wire.h"
+#include "atlink/utils/Deserializer.h"
+#include "atlink/utils/Serializer.h"
+
+#include <catch2/catch_all.hpp>
+#include <string>
+
+namespace {
+
+using ATL_NS::Core::WireProfile;
+using ATL_NS::Proto::Std::Error;
+using ATL_NS::Proto::Std::Ok;
+
+ATL_RESPONSE(CsqResponse, "+CSQ: %d,%d", rssi, ber);
+ATL_COMMAND(CsqCommand, "AT+CSQ");
+
+constexpr WireProfile Numeric{'\r', '\n', false};
+
+} // namespace
+
+SCENARIO("Final result codes follow the wire profile") {
+
+    GIVEN("Numeric result codes") {
+        ATL_NS::Core::FinalResultCode<> frc{};
+
+        WHEN("A numeric OK is received") {
+            atlink::Utils::Deserializer deserializer{"0\r", Numeric};
+            auto success = frc.accept(deserializer);
+            THEN("It is recognised by its number") {
+                REQUIRE(success);
+                REQUIRE(frc.holds<Ok>());
+                REQUIRE(2U == deserializer.consumed());
+            }
+        }
+
+        WHEN("A numeric ERROR is received") {
+            atlink::Utils::Deserializer deserializer{"4\r", Numeric};
+            auto success = frc.accept(deserializer);
+            THEN("It is recognised by its number") {
+                REQUIRE(success);
+                REQUIRE(frc.holds<Error>());
+            }
+        }
+
+        WHEN("The modem still answers verbosely") {
+            atlink::Utils::Deserializer deserializer{"\r\nOK\r\n", Numeric};
+            auto success = frc.accept(deserializer);
+            THEN("The text is accepted as well") {
+                REQUIRE(success);
+                REQUIRE(frc.holds<Ok>());
+            }
+        }
+
+        WHEN("An information response precedes the result") {
+            auto res = CsqResponse{};
+            atlink::Utils::Deserializer deserializer{"+CSQ: 21,99\r\n0\r", Numeric};
+            auto success = res.accept(deserializer);
+            THEN("It is still framed by S3 S4") {
+                REQUIRE(success);
+                REQUIRE(21 == res.rssi);
+                REQUIRE(13U == deserializer.consumed());
+            }
+        }
+    }
+
+    GIVEN("Verbose result codes") {
+        ATL_NS::Core::FinalResultCode<> frc{};
+
+        WHEN("A number is received") {
+            atlink::Utils::Deserializer deserializer{"0\r"};
+            auto success = frc.accept(deserializer);
+            THEN("It is not taken for a result code") {
+                REQUIRE_FALSE(success);
+            }
+        }
+
+        WHEN("ERROR follows an empty line") {
+            atlink::Utils::Deserializer deserializer{"\r\nERROR\r\n"};
+            auto success = frc.accept(deserializer);
+            THEN("The leading line end is skipped") {
+                REQUIRE(success);
+                REQUIRE(frc.holds<Error>());
+            }
+        }
+    }
+
+    GIVEN("Custom S3 and S4 characters") {
+        constexpr WireProfile custom{'|', '~', true};
+
+        WHEN("A response is received") {
+            auto res = CsqResponse{};
+            atlink::Utils::Deserializer deserializer{"|~+CSQ: 5,0|~", custom};
+            auto success = res.accept(deserializer);
+            THEN("It is framed by them") {
+                REQUIRE(success);
+                REQUIRE(5 == res.rssi);
+                REQUIRE(13U == deserializer.consumed());
+            }
+        }
+
+        WHEN("A command is serialized") {
+            char buf[16U];
+            auto serializer = ATL_NS::Utils::Serializer{buf, custom};
+            auto success = CsqCommand{}.accept(serializer);
+            THEN("It is terminated by S3") {
+                REQUIRE(success);
+                REQUIRE(std::string{"AT+CSQ|"} == buf);
+            }
+        }
+    }
+}
+
+SCENARIO("Wire profile is negotiated with a single command") {
+
+    GIVEN("The command for numeric result codes") {
+        ATL_NS::Proto::Std::Wire::Write::Command cmd{};
+        cmd.s3 = Numeric.s3;
+        cmd.s4 = Numeric.s4;
+        cmd.verbose = 0;
+
+        WHEN("Serialized") {
+            char buf[32U];
+            auto serializer = ATL_NS::Utils::Serializer{buf};
+            auto success = cmd.accept(serializer);
+            THEN("All settings share one command line") {
+                REQUIRE(success);
+                REQUIRE(std::string{"ATS3=13S4=10V0\r"} == buf);
+            }
+        }
+    }
+}